@@ -1,6 +1,7 @@
 #include "mainwindow.h"
 
 #include "../services/renderer/renderservice.h"
+#include "../services/trace/trace.h"
 #include "toolsetprofile.h"
 
 #include <ZFontIcon/ZFontIcon.h>
@@ -10,6 +11,7 @@
 #include <nw/log.hpp>
 
 #include <QApplication>
+#include <QPixmapCache>
 #include <QStyleFactory>
 
 int main(int argc, char* argv[])
@@ -25,6 +27,12 @@ int main(int argc, char* argv[])
     QCoreApplication::setApplicationName("arclight");
     QCoreApplication::setApplicationVersion("1.0.0");
 
+    // --trace <file> or ARCLIGHT_TRACE=<file>
+    tracer().start_from(app.arguments());
+
+    // Icon models share the pixmap cache, loadscreens are large enough to evict a scrolled list at the default 10MB.
+    QPixmapCache::setCacheLimit(64 * 1024);
+
 #if defined(Q_OS_WIN)
     app.setStyle(QStyleFactory::create("Fusion"));
     QPalette darkPalette;
@@ -53,5 +61,7 @@ int main(int argc, char* argv[])
 
     MainWindow main;
     main.showMaximized();
-    return app.exec();
+    auto result = app.exec();
+    tracer().stop();
+    return result;
 }
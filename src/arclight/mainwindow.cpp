@@ -1,6 +1,8 @@
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
 
+#include "services/renderer/renderservice.h"
+#include "services/trace/trace.h"
 #include "widgets/AbstractTreeModel.hpp"
 #include "widgets/ArclightView.h"
 #include "widgets/AreaView/areaview.h"
@@ -20,7 +22,10 @@
 #include "widgets/arealistview.h"
 #include "widgets/explorerview.h"
 #include "widgets/projectview.h"
+#include "widgets/util/savepipeline.h"
 #include "widgets/util/strings.h"
+#include "widgets/util/tlkindex.h"
+#include "widgets/util/undohistory.h"
 
 #include "nw/formats/Dialog.hpp"
 #include "nw/kernel/Resources.hpp"
@@ -31,6 +36,7 @@
 #include <QFileDialog>
 #include <QMessageBox>
 #include <QPluginLoader>
+#include <QStatusBar>
 #include <QTreeView>
 #include <QUndoStack>
 #include <QtConcurrent/QtConcurrent>
@@ -87,6 +93,8 @@ MainWindow::~MainWindow()
 
 void MainWindow::closeEvent(QCloseEvent* event)
 {
+    // Don't exit with a half written file
+    save_pipeline().waitForDone();
     writeSettings();
     QMainWindow::closeEvent(event);
 }
@@ -170,6 +178,7 @@ void MainWindow::loadCallbacks()
 
 void MainWindow::loadTreeviews()
 {
+    TRACE_SCOPE("MainWindow::loadTreeviews");
     auto result = mod_load_watcher_->result();
     delete mod_load_watcher_;
     module_ = result[0];
@@ -178,6 +187,10 @@ void MainWindow::loadTreeviews()
     }
     module_container_ = dynamic_cast<nw::StaticDirectory*>(nw::kernel::resman().module_container());
 
+    // Start indexing strings now so the first search doesn't have to wait.
+    reset_kernel_tlk_index();
+    kernel_tlk_index();
+
     ui->placeHolder->setHidden(true);
 
     auto project_view = new ProjectView(module_container_, this);
@@ -196,6 +209,7 @@ void MainWindow::loadTreeviews()
     treeview_load_future_ = QtConcurrent::run([views = this->project_treeviews_] {
         QList<AbstractTreeModel*> res;
         for (auto it : views) {
+            TRACE_SCOPE_ARG("loadModel", it->metaObject()->className());
             res.push_back(it->loadModel());
         }
         return res;
@@ -223,6 +237,7 @@ void MainWindow::open(const QString& path)
         recentActions_[i]->setVisible(true);
     }
 
+    renderer().unload_module();
     nw::kernel::services().shutdown();
     // Since module is loading we're just creating services on the main thread.
     nw::kernel::services().create();
@@ -232,6 +247,7 @@ void MainWindow::open(const QString& path)
     connect(mod_load_watcher_, &QFutureWatcher<QList<nw::Module*>>::finished, this, &MainWindow::loadTreeviews);
 
     mod_load_future_ = QtConcurrent::run([path = module_path_.toStdString()] {
+        TRACE_SCOPE_ARG("nw::kernel::load_module", path);
         return QList<nw::Module*>{nw::kernel::load_module(path, false)};
     });
     mod_load_watcher_->setFuture(mod_load_future_);
@@ -248,6 +264,11 @@ void MainWindow::readSettings()
         recentProjects_.append(settings.value("file").toString());
     }
     settings.endArray();
+
+    auto& undo = undo_history_config();
+    undo.budget = qsizetype(settings.value("Undo/budget_mb", int(undo.budget >> 20)).toInt()) << 20;
+    undo.limit = settings.value("Undo/limit", undo.limit).toInt();
+    undo.spill_to_disk = settings.value("Undo/spill_to_disk", undo.spill_to_disk).toBool();
 }
 
 void MainWindow::writeSettings()
@@ -325,6 +346,7 @@ void MainWindow::onActionCloseProject(bool checked)
     }
     project_treeviews_.clear();
     nw::kernel::unload_module();
+    renderer().unload_module();
 }
 
 void MainWindow::onActionOpen(bool checked)
@@ -387,6 +409,8 @@ void MainWindow::onProjectDoubleClicked(ProjectItem* item)
     auto it = type_to_view_.find(item->res_.type);
     if (it == std::end(type_to_view_)) { return; }
 
+    TRACE_SCOPE_ARG("MainWindow::openView", item->res_.filename());
+
     auto view = it->second(item->res_);
     connect(view, &ArclightView::modificationChanged, this, &MainWindow::onModificationChanged);
     connect(view, &ArclightView::activateUndoStack, this, &MainWindow::onActivateUndoStack);
@@ -410,6 +434,17 @@ void MainWindow::onProjectViewChanged(int index)
 void MainWindow::onTabCloseRequested(int index)
 {
     auto cw = reinterpret_cast<ArclightView*>(ui->tabWidget->widget(index));
+    if (!cw) { return; }
+
+    // The view reports the save's result, close once it has rather than dropping it.
+    if (cw->saving()) {
+        statusBar()->showMessage(QString("Waiting for '%1' to finish saving...").arg(ui->tabWidget->tabText(index)), 3000);
+        connect(cw, &ArclightView::saveFinished, this, [this, cw]() {
+            if (!cw->saving()) { onTabCloseRequested(ui->tabWidget->indexOf(cw)); }
+        }, static_cast<Qt::ConnectionType>(Qt::QueuedConnection | Qt::SingleShotConnection));
+        return;
+    }
+
     ui->tabWidget->removeTab(index);
     delete cw;
     if (ui->tabWidget->count() == 0) {
@@ -437,7 +472,9 @@ void MainWindow::onTreeviewsLoaded()
 
     Q_UNUSED(result);
 
+    TRACE_SCOPE("MainWindow::onTreeviewsLoaded");
     foreach (auto it, project_treeviews_) {
+        TRACE_SCOPE_ARG("activateModel", it->metaObject()->className());
         it->activateModel();
     }
 
@@ -0,0 +1,118 @@
+#include "benchmark.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QSysInfo>
+#include <QThread>
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <limits>
+
+void BenchmarkRunner::add(Benchmark bench)
+{
+    benchmarks_.push_back(std::move(bench));
+}
+
+QStringList BenchmarkRunner::names() const
+{
+    QStringList result;
+    for (const auto& bench : benchmarks_) {
+        result << bench.name;
+    }
+    return result;
+}
+
+std::vector<BenchmarkResult> BenchmarkRunner::run(const QRegularExpression& filter, int iterations)
+{
+    std::vector<BenchmarkResult> results;
+
+    std::printf("%-48s %12s %12s %12s %12s %10s\n", "Benchmark", "Time (ms)", "Min (ms)", "Max (ms)",
+        "CPU (ms)", "Iterations");
+    std::printf("%s\n", QString(112, '-').toStdString().c_str());
+
+    for (const auto& bench : benchmarks_) {
+        if (!filter.match(bench.name).hasMatch()) { continue; }
+
+        BenchmarkResult result;
+        result.name = bench.name;
+        result.iterations = bench.iterations > 0 ? bench.iterations : iterations;
+        result.real_time_min = std::numeric_limits<double>::max();
+
+        double real_total = 0.0;
+        double cpu_total = 0.0;
+        for (int i = 0; i < result.iterations; ++i) {
+            if (bench.setup) { bench.setup(); }
+
+            QElapsedTimer timer;
+            auto cpu_start = std::clock();
+            timer.start();
+            bench.run();
+            auto real = double(timer.nsecsElapsed()) / 1e6;
+            auto cpu = double(std::clock() - cpu_start) * 1000.0 / CLOCKS_PER_SEC;
+
+            // Let deferred deletes and queued signals settle outside of the timed region.
+            QCoreApplication::processEvents();
+
+            real_total += real;
+            cpu_total += cpu;
+            result.real_time_min = std::min(result.real_time_min, real);
+            result.real_time_max = std::max(result.real_time_max, real);
+        }
+
+        if (result.iterations > 0) {
+            result.real_time = real_total / result.iterations;
+            result.cpu_time = cpu_total / result.iterations;
+        } else {
+            result.real_time_min = 0.0;
+        }
+
+        std::printf("%-48s %12.3f %12.3f %12.3f %12.3f %10d\n", result.name.toStdString().c_str(),
+            result.real_time, result.real_time_min, result.real_time_max, result.cpu_time, result.iterations);
+        std::fflush(stdout);
+        results.push_back(result);
+    }
+
+    return results;
+}
+
+QJsonObject BenchmarkRunner::to_json(const std::vector<BenchmarkResult>& results, const QJsonObject& context)
+{
+    QJsonObject ctx{
+        {"date", QDateTime::currentDateTime().toString(Qt::ISODate)},
+        {"host_name", QSysInfo::machineHostName()},
+        {"executable", QCoreApplication::applicationFilePath()},
+        {"num_cpus", QThread::idealThreadCount()},
+#ifdef NDEBUG
+        {"library_build_type", "release"},
+#else
+        {"library_build_type", "debug"},
+#endif
+    };
+    for (auto it = context.begin(); it != context.end(); ++it) {
+        ctx.insert(it.key(), it.value());
+    }
+
+    QJsonArray benchmarks;
+    for (const auto& result : results) {
+        benchmarks.append(QJsonObject{
+            {"name", result.name},
+            {"run_name", result.name},
+            {"run_type", "iteration"},
+            {"iterations", result.iterations},
+            {"real_time", result.real_time},
+            {"cpu_time", result.cpu_time},
+            {"time_unit", "ms"},
+            {"real_time_min", result.real_time_min},
+            {"real_time_max", result.real_time_max},
+        });
+    }
+
+    return QJsonObject{
+        {"context", ctx},
+        {"benchmarks", benchmarks},
+    };
+}
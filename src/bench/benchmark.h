@@ -0,0 +1,49 @@
+#pragma once
+
+#include <QJsonObject>
+#include <QRegularExpression>
+#include <QString>
+#include <QStringList>
+
+#include <functional>
+#include <vector>
+
+// == Benchmark ===============================================================
+// ============================================================================
+
+struct Benchmark {
+    QString name;
+    std::function<void()> run;
+    std::function<void()> setup; ///< Runs before every iteration, untimed
+    int iterations = 0;          ///< If 0, the runner's default is used
+};
+
+struct BenchmarkResult {
+    QString name;
+    int iterations = 0;
+    double real_time = 0.0; ///< Mean wall time in milliseconds
+    double real_time_min = 0.0;
+    double real_time_max = 0.0;
+    double cpu_time = 0.0; ///< Mean process CPU time in milliseconds, includes worker threads
+};
+
+// == BenchmarkRunner =========================================================
+// ============================================================================
+
+/// Minimal harness producing Google Benchmark compatible JSON
+class BenchmarkRunner {
+public:
+    void add(Benchmark bench);
+
+    /// Names of all registered benchmarks
+    QStringList names() const;
+
+    /// Runs every benchmark matching ``filter``, printing a row per benchmark as it finishes
+    std::vector<BenchmarkResult> run(const QRegularExpression& filter, int iterations);
+
+    /// Converts results to Google Benchmark's JSON layout, ``context`` is merged into its context object
+    static QJsonObject to_json(const std::vector<BenchmarkResult>& results, const QJsonObject& context);
+
+private:
+    std::vector<Benchmark> benchmarks_;
+};
@@ -0,0 +1,267 @@
+#include "benchmark.h"
+#include "syntheticmodule.h"
+
+#include "../arclight/toolsetprofile.h"
+#include "../services/renderer/TextureCache.hpp"
+#include "../services/renderer/model.hpp"
+#include "../services/renderer/renderservice.h"
+#include "../services/toolset/toolsetservice.h"
+#include "../services/trace/trace.h"
+#include "explorerview.h"
+#include "projectview.h"
+
+#include <nowide/args.hpp>
+#include <nw/kernel/Kernel.hpp>
+#include <nw/kernel/Resources.hpp>
+#include <nw/log.hpp>
+#include <nw/resources/Erf.hpp>
+#include <nw/resources/StaticDirectory.hpp>
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QJsonDocument>
+#include <QTemporaryDir>
+
+#include <cstdio>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Fuzzy filter inputs, typed one character at a time like a user would.
+const char* const filter_queries[] = {"c", "cr", "cre", "crea", "bn", "bn00", "bn001", "zzz"};
+
+std::vector<std::string> collect_resrefs(std::initializer_list<nw::ResourceType::type> types, size_t limit,
+    std::string_view prefix = {})
+{
+    std::vector<std::string> result;
+    nw::kernel::resman().visit([&](const nw::Resource& res) {
+        if (result.size() >= limit) { return; }
+        if (!prefix.empty() && !res.resref.view().starts_with(prefix)) { return; }
+        result.emplace_back(res.resref.view());
+    },
+        types);
+    return result;
+}
+
+// Benchmarks are registered before the synthetic module exists, so ``--list`` doesn't need one.
+// Anything that reads resources is deferred to a benchmark's setup.
+struct BenchContext {
+    nw::StaticDirectory* module = nullptr;
+    QObject* owner = nullptr;
+    int resources = 0;
+};
+
+void add_toolset_benchmarks(BenchmarkRunner& runner, const BenchContext& ctx)
+{
+    runner.add({"ToolsetService::initialize", []() {
+                    toolset().initialize(nw::kernel::ServiceInitTime::module_post_load);
+                }, {}, 3});
+
+    runner.add({"ProjectModel::loadRootItems", [&ctx]() {
+                    ProjectModel model{ctx.module};
+                    model.loadRootItems();
+                }});
+
+    runner.add({"ExplorerModel::loadRootItems", []() {
+                    ExplorerModel model;
+                    model.loadRootItems();
+                }});
+
+    struct FilterModels {
+        ExplorerProxy* explorer = nullptr;
+        ProjectProxyModel* project = nullptr;
+    };
+    auto models = std::make_shared<FilterModels>();
+    auto setup = [&ctx, models]() {
+        if (models->explorer) { return; }
+        auto explorer = new ExplorerModel(ctx.owner);
+        explorer->loadRootItems();
+        models->explorer = new ExplorerProxy(ctx.owner);
+        models->explorer->setSourceModel(explorer);
+
+        auto project = new ProjectModel(ctx.module, ctx.owner);
+        project->loadRootItems();
+        models->project = new ProjectProxyModel(ctx.owner);
+        models->project->setSourceModel(project);
+    };
+
+    runner.add({"ExplorerProxy::filter", [models]() {
+                    for (auto query : filter_queries) {
+                        models->explorer->onFilterChanged(query);
+                    }
+                    models->explorer->onFilterChanged({});
+                }, setup});
+
+    runner.add({"ProjectProxyModel::filter", [models]() {
+                    for (auto query : filter_queries) {
+                        models->project->onFilterChanged(query);
+                    }
+                    models->project->onFilterChanged({});
+                }, setup});
+}
+
+void add_render_benchmarks(BenchmarkRunner& runner, const BenchContext& ctx)
+{
+    struct RenderData {
+        bool collected = false;
+        std::vector<std::string> textures;
+        std::vector<std::string> models;
+        std::vector<std::unique_ptr<Model>> animated;
+    };
+    auto data = std::make_shared<RenderData>();
+    auto setup = [&ctx, data]() {
+        if (data->collected) { return; }
+        data->collected = true;
+        data->textures = collect_resrefs({nw::ResourceType::dds, nw::ResourceType::tga}, size_t(ctx.resources));
+        data->models = collect_resrefs({nw::ResourceType::mdl}, size_t(ctx.resources));
+        for (const auto& resref : collect_resrefs({nw::ResourceType::mdl}, 16, "c_")) {
+            auto model = load_model(resref);
+            if (model && model->load_animation("pause1")) {
+                data->animated.push_back(std::move(model));
+            }
+        }
+        LOG_F(INFO, "[bench] {} textures, {} models, {} animated models", data->textures.size(),
+            data->models.size(), data->animated.size());
+    };
+
+    // Names carry the requested counts, fewer are loaded if the module doesn't have that many.
+    runner.add({QString("load_texture/%1").arg(ctx.resources), [data]() {
+                    for (const auto& resref : data->textures) {
+                        load_texture(resref);
+                    }
+                }, setup});
+
+    runner.add({QString("load_model/%1").arg(ctx.resources), [data]() {
+                    for (const auto& resref : data->models) {
+                        load_model(resref);
+                    }
+                }, setup});
+
+    // 10 seconds of animation at 60fps per model.
+    runner.add({"Model::update/16", [data]() {
+                    for (int frame = 0; frame < 600; ++frame) {
+                        for (auto& model : data->animated) {
+                            model->update(16);
+                        }
+                    }
+                }, setup});
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    nowide::args _(argc, argv);
+    nw::init_logger(argc, argv);
+
+    // Nothing is shown, don't require a display.
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QApplication app{argc, argv};
+    QCoreApplication::setApplicationName("arclight_bench");
+    QCoreApplication::setApplicationVersion("1.0.0");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Benchmarks arclight's hot paths against a generated module and hak");
+    parser.addHelpOption();
+    parser.addOptions({
+        {"module", "Directory module used as the seed for the synthetic module.", "path"},
+        {"copies", "Number of clones of each resource in the synthetic module and hak.", "count", "20"},
+        {"iterations", "Default number of iterations per benchmark.", "count", "5"},
+        {"resources", "Number of textures and models loaded by the render benchmarks.", "count", "200"},
+        {"filter", "Only run benchmarks matching this regular expression.", "regex", "."},
+        {"out", "Write Google Benchmark compatible JSON results to this file.", "path"},
+        {"trace", "Write a Chrome/Perfetto trace of the run to this file.", "path"},
+        {"list", "List benchmarks and exit."},
+        {"no-render", "Skip benchmarks that need a render device."},
+    });
+    parser.process(app);
+    tracer().start_from(app.arguments());
+
+    BenchContext ctx;
+    ctx.owner = &app;
+    ctx.resources = parser.value("resources").toInt();
+
+    bool render = !parser.isSet("no-render");
+    BenchmarkRunner runner;
+    add_toolset_benchmarks(runner, ctx);
+
+    if (parser.isSet("list")) {
+        if (render) {
+            add_render_benchmarks(runner, ctx);
+        }
+        for (const auto& name : runner.names()) {
+            std::printf("%s\n", name.toStdString().c_str());
+        }
+        return 0;
+    }
+
+    if (!parser.isSet("module")) {
+        LOG_F(ERROR, "[bench] --module is required");
+        parser.showHelp(1);
+    }
+
+    QTemporaryDir workdir;
+    auto module_path = workdir.filePath("module");
+    auto hak_path = workdir.filePath("arclight_bench.hak");
+    int copies = parser.value("copies").toInt();
+    if (!workdir.isValid()
+        || generate_synthetic_module(parser.value("module"), module_path, copies) < 0
+        || generate_synthetic_hak(parser.value("module"), hak_path, copies) < 0) {
+        return 1;
+    }
+
+    nw::kernel::config().initialize();
+    nw::kernel::set_game_profile(new ToolsetProfile);
+    nw::kernel::services().start();
+
+    if (render) {
+        try {
+            renderer().initialize(nw::kernel::ServiceInitTime::kernel_start);
+        } catch (const std::exception& e) {
+            LOG_F(WARNING, "[bench] no render device, skipping render benchmarks: {}", e.what());
+            render = false;
+        }
+    }
+    if (render) {
+        add_render_benchmarks(runner, ctx);
+    }
+
+    auto module = nw::kernel::load_module(module_path.toStdString(), false);
+    if (!module) {
+        LOG_F(ERROR, "[bench] failed to load synthetic module");
+        return 1;
+    }
+    ctx.module = dynamic_cast<nw::StaticDirectory*>(nw::kernel::resman().module_container());
+
+    // Haks are looked up by name in the user's hak directory, add the synthetic one directly instead.
+    nw::kernel::resman().add_custom_container(new nw::Erf(hak_path.toStdString()), true);
+
+    QRegularExpression filter{parser.value("filter")};
+    auto results = runner.run(filter, parser.value("iterations").toInt());
+    tracer().stop();
+
+    if (parser.isSet("out")) {
+        QJsonObject context{
+            {"arclight_version", QCoreApplication::applicationVersion()},
+            {"seed_module", parser.value("module")},
+            {"copies", copies},
+            {"render_device", render ? QString::fromStdString(renderer().device_type_as_string()) : QString("none")},
+        };
+
+        QFile file(parser.value("out"));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            LOG_F(ERROR, "[bench] failed to open '{}'", parser.value("out").toStdString());
+            return 1;
+        }
+        file.write(QJsonDocument(BenchmarkRunner::to_json(results, context)).toJson());
+    }
+
+    return 0;
+}
@@ -0,0 +1,107 @@
+#include "syntheticmodule.h"
+
+#include "ContainerView/ErfWriter.hpp"
+
+#include <nw/log.hpp>
+#include <nw/resources/Resource.hpp>
+
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QSet>
+
+namespace {
+
+const QSet<QString>& cloned_extensions()
+{
+    static const QSet<QString> s_extensions{"dlg", "utc", "utd", "ute", "uti", "utm", "utp", "uts", "utt", "utw"};
+    return s_extensions;
+}
+
+const QSet<QString>& hak_extensions()
+{
+    static const QSet<QString> s_extensions{"dlg", "utc", "utd", "ute", "uti", "utm", "utp", "uts", "utt", "utw",
+        "mdl", "dds", "tga"};
+    return s_extensions;
+}
+
+} // namespace
+
+int generate_synthetic_module(const QString& seed, const QString& output, int copies)
+{
+    QDir seed_dir(seed);
+    if (!seed_dir.exists("module.ifo")) {
+        LOG_F(ERROR, "[bench] '{}' is not a directory module", seed.toStdString());
+        return -1;
+    }
+
+    QDir out_dir(output);
+    if (!out_dir.mkpath(".")) {
+        LOG_F(ERROR, "[bench] failed to create '{}'", output.toStdString());
+        return -1;
+    }
+
+    int written = 0;
+    int clone_index = 0;
+    QDirIterator it(seed, QDir::Files | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        auto path = it.next();
+        auto relative = seed_dir.relativeFilePath(path);
+        if (relative.startsWith(".arclight_meta")) { continue; }
+
+        auto dest = out_dir.filePath(relative);
+        out_dir.mkpath(QFileInfo(relative).path());
+        QFile::remove(dest);
+        if (!QFile::copy(path, dest)) {
+            LOG_F(ERROR, "[bench] failed to copy '{}'", path.toStdString());
+            return -1;
+        }
+        ++written;
+
+        auto ext = QFileInfo(path).suffix().toLower();
+        if (!cloned_extensions().contains(ext)) { continue; }
+
+        for (int i = 0; i < copies; ++i, ++clone_index) {
+            // Module directories are flat, clones live next to the seed's files.
+            auto clone = out_dir.filePath(QString("bn%1.%2").arg(clone_index, 7, 10, QChar('0')).arg(ext));
+            QFile::remove(clone);
+            if (!QFile::copy(path, clone)) {
+                LOG_F(ERROR, "[bench] failed to write '{}'", clone.toStdString());
+                return -1;
+            }
+            ++written;
+        }
+    }
+
+    LOG_F(INFO, "[bench] generated synthetic module with {} files in '{}'", written, output.toStdString());
+    return written;
+}
+
+int generate_synthetic_hak(const QString& seed, const QString& output, int copies)
+{
+    ErfWriter writer;
+    int clone_index = 0;
+    QDirIterator it(seed, QDir::Files | QDir::NoDotAndDotDot);
+    while (it.hasNext()) {
+        auto path = it.next();
+        auto ext = QFileInfo(path).suffix().toLower();
+        if (!hak_extensions().contains(ext)) { continue; }
+
+        for (int i = 0; i < copies; ++i, ++clone_index) {
+            ErfWriteEntry entry;
+            entry.name = nw::Resource::from_filename(QString("bh%1.%2").arg(clone_index, 7, 10, QChar('0')).arg(ext).toStdString());
+            entry.source = path.toStdString();
+            entry.whole_file = true;
+            writer.entries.push_back(std::move(entry));
+        }
+    }
+
+    if (!writer.write(output.toStdString())) {
+        LOG_F(ERROR, "[bench] failed to write '{}': {}", output.toStdString(), writer.error);
+        return -1;
+    }
+
+    LOG_F(INFO, "[bench] generated synthetic hak with {} resources in '{}'", writer.entries.size(), output.toStdString());
+    return int(writer.entries.size());
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <QString>
+
+/// Builds a benchmark module in ``output`` from the directory module at ``seed``.
+///
+/// The seed is copied as is, then every blueprint and dialog is cloned ``copies`` times under
+/// generated resrefs. The seed's module.ifo is kept, so haks are whatever the seed module references.
+/// Returns the number of files written or -1 on failure.
+int generate_synthetic_module(const QString& seed, const QString& output, int copies);
+
+/// Writes a hak to ``output`` holding ``copies`` clones of every blueprint, dialog, model and texture
+/// in the directory module at ``seed``, so lookups also have to go through an ERF.
+/// Returns the number of resources written or -1 on failure.
+int generate_synthetic_hak(const QString& seed, const QString& output, int copies);
@@ -4,6 +4,7 @@
 #include "DialogView/dialogmodel.h"
 #include "DialogView/dialogview.h"
 #include "fontchooserdialog.h"
+#include "widgets/util/savepipeline.h"
 #include "widgets/util/strings.h"
 
 #include "nw/formats/Dialog.hpp"
@@ -234,6 +235,8 @@ void MainWindow::writeSettings()
 
 void MainWindow::closeEvent(QCloseEvent* event)
 {
+    // Don't exit with a half written file
+    save_pipeline().waitForDone();
     writeSettings();
     QMainWindow::closeEvent(event);
 }
@@ -1,17 +1,28 @@
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
 
+#include "ContainerView/ErfIndex.hpp"
+#include "ContainerView/ErfWriter.hpp"
 #include "LanguageMenu/LanguageMenu.h"
+#include "services/fileio/fileio.h"
 #include "widgets/util/strings.h"
 
 #include <nw/log.hpp>
 #include <nw/resources/Erf.hpp>
+#include <nw/util/platform.hpp>
 
 #include <QApplication>
+#include <QCloseEvent>
 #include <QFileDialog>
+#include <QFutureWatcher>
 #include <QMessageBox>
+#include <QProgressDialog>
+#include <QtConcurrent/QtConcurrent>
 
+#include <algorithm>
 #include <filesystem>
+#include <memory>
+#include <tuple>
 namespace fs = std::filesystem;
 
 MainWindow::MainWindow(QWidget* parent)
@@ -69,6 +80,11 @@ ContainerView* MainWindow::current()
 
 void MainWindow::closeEvent(QCloseEvent* event)
 {
+    if (!running_.isEmpty()) {
+        statusBar()->showMessage("Waiting for exports and saves to finish...", 3000);
+        event->ignore();
+        return;
+    }
     writeSettings();
     QMainWindow::closeEvent(event);
 }
@@ -168,12 +184,11 @@ void MainWindow::onActionExport()
     auto path = QFileDialog::getExistingDirectory(this, "Export To...");
     if (path.isEmpty()) { return; }
 
-    auto select = current()->table()->selectionModel()->selectedRows();
-    for (const auto& s : select) {
-        auto idx = current()->model()->index(s.row(), 0);
-        auto fname = idx.data(Qt::DisplayRole).toString().toStdString();
-        current()->container()->extract_by_glob(fname, path.toStdString());
+    QModelIndexList rows;
+    for (const auto& s : current()->table()->selectionModel()->selectedRows()) {
+        rows.append(current()->proxy()->mapToSource(s));
     }
+    exportEntries(current(), current()->model()->writeEntries(rows), path);
 }
 
 void MainWindow::onActionExportAll()
@@ -183,17 +198,18 @@ void MainWindow::onActionExportAll()
     auto path = QFileDialog::getExistingDirectory(this, "Export To...");
     if (path.isEmpty()) { return; }
 
-    if (auto c = current()->container()) {
-        c->extract(std::regex(".*"), path.toStdString());
-    }
+    exportEntries(current(), current()->model()->writeEntries(), path);
 }
 
 void MainWindow::onActionDelete()
 {
-    QModelIndexList idxs;
-    while ((idxs = current()->table()->selectionModel()->selectedIndexes()).size()) {
-        current()->proxy()->removeRow(idxs.first().row());
+    if (!current()) { return; }
+
+    QModelIndexList rows;
+    for (const auto& s : current()->table()->selectionModel()->selectedIndexes()) {
+        rows.append(current()->proxy()->mapToSource(s));
     }
+    current()->model()->removeIndexes(rows);
 }
 
 void MainWindow::onActionSave()
@@ -201,10 +217,9 @@ void MainWindow::onActionSave()
     if (!current()) { return; }
     if (current()->container()->name().empty()) {
         onActionSaveAs();
-    } else if (auto e = dynamic_cast<nw::Erf*>(current()->container())) {
-        e->save();
-        e->reload();
-        setModifiedTabName(false);
+    } else if (dynamic_cast<nw::Erf*>(current()->container())) {
+        fs::path path{current()->container()->path()};
+        saveContainer(current(), to_qstring(nw::path_to_string(path)));
     }
 }
 
@@ -213,10 +228,8 @@ void MainWindow::onActionSaveAs()
     if (!current()) { return; }
     QString fn = QFileDialog::getSaveFileName(this, "Save As", "", "Erf (*.erf *.mod *.hak *.nwm *.sav)");
     if (fn.isEmpty()) { return; }
-    if (auto e = dynamic_cast<nw::Erf*>(current()->container())) {
-        e->save_as(fn.toStdString());
-        onTabCloseRequested(ui_->containerTabWidget->currentIndex());
-        open(fn);
+    if (dynamic_cast<nw::Erf*>(current()->container())) {
+        saveContainer(current(), fn);
     }
 }
 
@@ -273,6 +286,15 @@ void MainWindow::onRowsRemoved(const QModelIndex& parent, int first, int last)
 void MainWindow::onTabCloseRequested(int index)
 {
     auto cw = reinterpret_cast<ContainerView*>(ui_->containerTabWidget->widget(index));
+    if (!cw) { return; }
+
+    // Exports and saves read the container's working files, close once they've finished.
+    if (running_.contains(cw)) {
+        statusBar()->showMessage(QString("Waiting for '%1' to finish...").arg(ui_->containerTabWidget->tabText(index)), 3000);
+        close_pending_.insert(cw);
+        return;
+    }
+
     ui_->containerTabWidget->removeTab(index);
     delete cw;
     if (!current()) {
@@ -312,6 +334,8 @@ void MainWindow::connectModifiedSlots(ContainerModel* model)
         this, &MainWindow::onRowsInserted);
     QObject::connect(model, &QAbstractItemModel::rowsRemoved,
         this, &MainWindow::onRowsRemoved);
+    QObject::connect(model, &QAbstractItemModel::modelReset,
+        this, [this]() { setModifiedTabName(true); });
 }
 
 void MainWindow::enableModificationMenus(bool enabled)
@@ -327,6 +351,120 @@ void MainWindow::enableModificationMenus(bool enabled)
     ui_->actionExport_All->setEnabled(enabled);
 }
 
+void MainWindow::exportEntries(ContainerView* view, std::vector<ErfWriteEntry> entries, const QString& path)
+{
+    if (entries.empty()) { return; }
+
+    // Workers never touch the container, only files.
+    extract_write_entries(entries);
+
+    // Read each source front to back
+    std::sort(std::begin(entries), std::end(entries), [](const auto& a, const auto& b) {
+        return std::tie(a.source, a.offset) < std::tie(b.source, b.offset);
+    });
+
+    int count = static_cast<int>(entries.size());
+    auto progress = new QProgressDialog(QString("Exporting %1 resources...").arg(count), "Cancel", 0, count, this);
+    progress->setWindowModality(Qt::WindowModal);
+    progress->setMinimumDuration(500);
+
+    // Result is an error message, empty on success
+    auto watcher = new QFutureWatcher<QString>(this);
+    connect(watcher, &QFutureWatcher<QString>::progressValueChanged, progress, &QProgressDialog::setValue);
+    connect(progress, &QProgressDialog::canceled, watcher, &QFutureWatcher<QString>::cancel);
+    connect(watcher, &QFutureWatcher<QString>::finished, this, [this, watcher, progress, view, path]() {
+        progress->close();
+        progress->deleteLater();
+        watcher->deleteLater();
+        finishJob(view);
+        if (watcher->isCanceled()) { return; }
+
+        auto results = watcher->future().results();
+        auto failed = std::count_if(std::begin(results), std::end(results), [](const QString& r) { return !r.isEmpty(); });
+        if (failed) {
+            auto first = *std::find_if(std::begin(results), std::end(results), [](const QString& r) { return !r.isEmpty(); });
+            QMessageBox::warning(this, "Export", QString("Failed to export %1 resource(s) to '%2': %3").arg(failed).arg(path, first));
+        }
+    });
+
+    fs::path dest{path.toStdString()};
+    ++running_[view];
+    watcher->setFuture(QtConcurrent::mapped(std::move(entries), [dest](ErfWriteEntry e) {
+        std::string error;
+        if (!resolve_write_entry(e, error)) { return to_qstring(error); }
+        if (!copy_file_region(e.source, e.offset, e.size, dest / e.name.filename())) {
+            return QString("unable to write '%1'").arg(to_qstring(e.name.filename()));
+        }
+        return QString{};
+    }));
+}
+
+void MainWindow::saveContainer(ContainerView* view, const QString& path)
+{
+    ErfWriter writer;
+    writer.entries = view->model()->writeEntries();
+    writer.locstrings_from = view->container()->path();
+    extract_write_entries(writer.entries);
+
+    fs::path target{path.toStdString()};
+    fs::path temp = temp_path(target);
+
+    auto progress = new QProgressDialog(QString("Saving %1...").arg(path), "Cancel", 0, 1000, this);
+    progress->setWindowModality(Qt::WindowModal);
+    progress->setMinimumDuration(500);
+
+    // Result is an error message, empty on success
+    auto watcher = new QFutureWatcher<QString>(this);
+    connect(watcher, &QFutureWatcher<QString>::progressValueChanged, progress, &QProgressDialog::setValue);
+    connect(progress, &QProgressDialog::canceled, watcher, &QFutureWatcher<QString>::cancel);
+    connect(watcher, &QFutureWatcher<QString>::finished, this, [this, watcher, progress, view, path, temp, target]() {
+        progress->close();
+        progress->deleteLater();
+        watcher->deleteLater();
+        finishJob(view);
+
+        std::error_code ec;
+        if (watcher->isCanceled() || watcher->resultCount() == 0 || !watcher->result().isEmpty()) {
+            fs::remove(temp, ec);
+            if (!watcher->isCanceled() && watcher->resultCount()) {
+                QMessageBox::critical(this, "Save Failed", QString("Unable to save '%1': %2").arg(path, watcher->result()));
+            }
+            return;
+        }
+
+        // Close the view first, the container may be holding the original file open.
+        int index = ui_->containerTabWidget->indexOf(view);
+        if (index >= 0) { onTabCloseRequested(index); }
+
+        std::string error;
+        if (!replace_file(temp, target, &error)) {
+            QMessageBox::critical(this, "Save Failed", QString("Unable to replace '%1': %2").arg(path, to_qstring(error)));
+            return;
+        }
+        open(path);
+    });
+
+    ++running_[view];
+    watcher->setFuture(QtConcurrent::run([writer = std::move(writer), temp](QPromise<QString>& promise) mutable {
+        promise.setProgressRange(0, 1000);
+        bool ok = writer.write(temp, [&promise](uint64_t written, uint64_t total) {
+            promise.setProgressValue(static_cast<int>(written * 1000 / std::max<uint64_t>(total, 1)));
+            return !promise.isCanceled();
+        });
+        promise.addResult(ok ? QString{} : to_qstring(writer.error));
+    }));
+}
+
+void MainWindow::finishJob(ContainerView* view)
+{
+    if (--running_[view] > 0) { return; }
+    running_.remove(view);
+    if (close_pending_.remove(view)) {
+        int index = ui_->containerTabWidget->indexOf(view);
+        if (index >= 0) { onTabCloseRequested(index); }
+    }
+}
+
 void MainWindow::setModifiedTabName(bool modified)
 {
     auto name = current()->container()->name();
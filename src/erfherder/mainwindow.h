@@ -3,7 +3,9 @@
 
 #include "ContainerView/ContainerView.hpp"
 
+#include <QHash>
 #include <QMainWindow>
+#include <QSet>
 #include <QSettings>
 
 namespace Ui {
@@ -50,12 +52,18 @@ public slots:
 private:
     void connectModifiedSlots(ContainerModel* model);
     void enableModificationMenus(bool enabled);
+    void exportEntries(ContainerView* view, std::vector<ErfWriteEntry> entries, const QString& path);
+    /// Closes ``view`` if its close was held back and no export or save is left running
+    void finishJob(ContainerView* view);
+    void saveContainer(ContainerView* view, const QString& path);
     void setModifiedTabName(bool modified);
 
     Ui::MainWindow* ui_;
     ContainerView* currentContainer_;
     QStringList recentFiles_;
     QList<QAction*> recentActions_;
+    QHash<ContainerView*, int> running_; ///< Exports and saves in flight per view
+    QSet<ContainerView*> close_pending_;
 
     void readSettings();
 };
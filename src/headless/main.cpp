@@ -0,0 +1,288 @@
+#include "../arclight/toolsetprofile.h"
+#include "../services/renderer/model.hpp"
+#include "../services/renderer/renderservice.h"
+#include "../services/renderer/rendertarget.h"
+#include "../services/trace/trace.h"
+
+#include <nowide/args.hpp>
+#include <nw/kernel/Kernel.hpp>
+#include <nw/kernel/Objects.hpp>
+#include <nw/log.hpp>
+#include <nw/objects/Area.hpp>
+
+#include <glm/ext/matrix_clip_space.hpp>
+#include <glm/ext/matrix_transform.hpp>
+
+#include <QCommandLineParser>
+#include <QGuiApplication>
+#include <QImage>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+
+namespace {
+
+// Exit codes, distinct so CI can tell a broken run from a changed image.
+constexpr int exit_error = 1;
+constexpr int exit_mismatch = 2;
+
+// Frames advance by a fixed step so animated output only depends on the frame count.
+constexpr int32_t frame_step_ms = 16;
+
+struct ImageDiff {
+    int64_t pixels = 0; ///< Pixels with any channel differing by more than the tolerance
+    int max_delta = 0;  ///< Largest per channel difference
+};
+
+// Compares RGBA8888 images of the same size, ``diff`` gets differing pixels in red over a dimmed ``image``
+ImageDiff compare_images(const QImage& image, const QImage& reference, int tolerance, QImage* diff)
+{
+    ImageDiff result;
+    if (diff) { *diff = QImage(image.size(), QImage::Format_RGBA8888); }
+
+    for (int y = 0; y < image.height(); ++y) {
+        auto a = image.constScanLine(y);
+        auto b = reference.constScanLine(y);
+        auto out = diff ? diff->scanLine(y) : nullptr;
+        for (int x = 0; x < image.width() * 4; x += 4) {
+            int delta = 0;
+            for (int c = 0; c < 4; ++c) {
+                delta = std::max(delta, std::abs(int(a[x + c]) - int(b[x + c])));
+            }
+            result.max_delta = std::max(result.max_delta, delta);
+            const bool differs = delta > tolerance;
+            if (differs) { ++result.pixels; }
+            if (out) {
+                out[x + 0] = differs ? 255 : a[x + 0] / 4;
+                out[x + 1] = differs ? 0 : a[x + 1] / 4;
+                out[x + 2] = differs ? 0 : a[x + 2] / 4;
+                out[x + 3] = 255;
+            }
+        }
+    }
+    return result;
+}
+
+void print_stats(const RenderStats& stats, uint32_t width, uint32_t height)
+{
+    const auto& history = stats.history();
+    if (history.empty()) { return; }
+
+    const auto avg = stats.average();
+    double worst = 0.0;
+    for (const auto& frame : history) {
+        worst = std::max(worst, frame.cpu_total_ms());
+    }
+
+    std::printf("device      %s\n", renderer().device_type_as_string().c_str());
+    std::printf("frames      %zu at %ux%u\n", history.size(), width, height);
+    std::printf("cpu         %.3f ms avg, %.3f ms worst\n", avg.cpu_total_ms(), worst);
+    if (avg.gpu_ms >= 0.0) {
+        std::printf("gpu         %.3f ms avg\n", avg.gpu_ms);
+    } else {
+        std::printf("gpu         n/a\n");
+    }
+    for (size_t i = 0; i < render_stage_count; ++i) {
+        std::printf("  %-10s%.3f ms\n", render_stage_name(RenderStage(i)), avg.cpu_ms[i]);
+    }
+    std::printf("draws       %u\n", avg.draws);
+    std::printf("triangles   %llu\n", static_cast<unsigned long long>(avg.triangles));
+    std::printf("pso         %u\n", avg.pso_switches);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    nowide::args _(argc, argv);
+    nw::init_logger(argc, argv);
+
+    // Nothing is shown, don't require a display.
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QGuiApplication app{argc, argv};
+    QCoreApplication::setApplicationName("arclight_headless");
+    QCoreApplication::setApplicationVersion("1.0.0");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Renders a model or area offscreen, reports timings, and optionally "
+                                     "compares the result against a reference image. Exits with 2 if the "
+                                     "image doesn't match.");
+    parser.addHelpOption();
+    parser.addOptions({
+        {"module", "Directory module to load, required for areas.", "path"},
+        {"model", "Model to render.", "resref"},
+        {"animation", "Animation to play on the model.", "name"},
+        {"area", "Area to render, top down over its center.", "resref"},
+        {"size", "Image size.", "WxH", "512x512"},
+        {"warmup", "Frames rendered before timing, e.g. for texture uploads.", "count", "5"},
+        {"frames", "Frames rendered and timed.", "count", "60"},
+        {"out", "Write the last frame to this image file.", "path"},
+        {"reference", "Compare the last frame against this image.", "path"},
+        {"tolerance", "Largest per channel difference still considered equal.", "value", "2"},
+        {"max-diff", "Largest fraction of differing pixels that still passes.", "fraction", "0.001"},
+        {"diff", "Write an image highlighting differing pixels to this file.", "path"},
+        {"stats", "Write per-frame render statistics as CSV to this file.", "path"},
+        {"trace", "Write a Chrome/Perfetto trace of the run to this file.", "path"},
+    });
+    parser.process(app);
+    tracer().start_from(app.arguments());
+
+    if (parser.isSet("model") == parser.isSet("area")) {
+        LOG_F(ERROR, "[headless] exactly one of --model or --area is required");
+        parser.showHelp(exit_error);
+    }
+
+    auto size = parser.value("size").split('x');
+    const uint32_t width = size.size() == 2 ? size[0].toUInt() : 0;
+    const uint32_t height = size.size() == 2 ? size[1].toUInt() : 0;
+    if (width == 0 || height == 0) {
+        LOG_F(ERROR, "[headless] invalid --size '{}'", parser.value("size").toStdString());
+        return exit_error;
+    }
+
+    nw::kernel::config().initialize();
+    nw::kernel::set_game_profile(new ToolsetProfile);
+    nw::kernel::services().start();
+
+    try {
+        renderer().initialize(nw::kernel::ServiceInitTime::kernel_start);
+    } catch (const std::exception& e) {
+        LOG_F(ERROR, "[headless] no render device: {}", e.what());
+        return exit_error;
+    }
+
+    if (parser.isSet("module")) {
+        if (!nw::kernel::load_module(parser.value("module").toStdString(), false)) {
+            LOG_F(ERROR, "[headless] failed to load module '{}'", parser.value("module").toStdString());
+            return exit_error;
+        }
+    }
+
+    // Cameras match what ``BasicModelView`` and ``ModelView`` show when first opened.
+    const float aspect = float(width) / float(height);
+    RenderContext ctx;
+    std::unique_ptr<Node> scene;
+    nw::Area* area = nullptr;
+
+    if (parser.isSet("model")) {
+        auto model = load_model(parser.value("model").toStdString());
+        if (!model) {
+            LOG_F(ERROR, "[headless] failed to load model '{}'", parser.value("model").toStdString());
+            return exit_error;
+        }
+        if (parser.isSet("animation") && !model->load_animation(parser.value("animation").toStdString())) {
+            LOG_F(ERROR, "[headless] model has no animation '{}'", parser.value("animation").toStdString());
+            return exit_error;
+        }
+        ctx.view = glm::lookAt(glm::vec3{0.0f, 8.0f, 0.0f}, glm::vec3{0.0f}, glm::vec3{0.0f, 0.0f, 1.0f});
+        ctx.projection = glm::perspective(glm::radians(45.0f), aspect, 0.1f, 100.0f);
+        scene = std::move(model);
+    } else {
+        area = nw::kernel::objects().make_area(parser.value("area").toStdString());
+        if (!area) {
+            LOG_F(ERROR, "[headless] failed to load area '{}'", parser.value("area").toStdString());
+            return exit_error;
+        }
+        area->instantiate();
+
+        auto tiles = std::make_unique<BasicTileArea>(area);
+        tiles->load_tile_models();
+
+        glm::vec3 eye{area->width * 10.0f / 2.0f, area->height * 10.0f / 2.0f, 50.0f};
+        glm::vec3 front{0.0f, std::cos(glm::radians(-89.0f)), std::sin(glm::radians(-89.0f))};
+        ctx.view = glm::lookAt(eye, eye + front, glm::vec3{0.0f, 0.0f, 1.0f});
+        ctx.projection = glm::perspective(glm::radians(45.0f), aspect, 0.1f, 1000.0f);
+        scene = std::move(tiles);
+    }
+
+    auto update = [&scene]() {
+        if (auto model = dynamic_cast<Model*>(scene.get())) {
+            model->update(frame_step_ms);
+        } else if (auto tiles = dynamic_cast<BasicTileArea*>(scene.get())) {
+            tiles->update(frame_step_ms);
+        }
+    };
+    auto draw = [&scene, &ctx]() { scene->draw(ctx, glm::mat4{1.0f}); };
+
+    RenderTarget target;
+    QImage image(int(width), int(height), QImage::Format_RGBA8888);
+    if (!target.initialize(width, height)) {
+        LOG_F(ERROR, "[headless] failed to create render target");
+        return exit_error;
+    }
+
+    const int warmup = std::max(0, parser.value("warmup").toInt());
+    const int frames = std::max(1, parser.value("frames").toInt());
+    for (int i = 0; i < warmup; ++i) {
+        target.render(update, draw, image.bits(), size_t(image.bytesPerLine()));
+    }
+    renderer().stats().clear();
+
+    {
+        TRACE_SCOPE_ARG("headless frames", std::to_string(frames));
+        for (int i = 0; i < frames; ++i) {
+            if (!target.render(update, draw, image.bits(), size_t(image.bytesPerLine()))) {
+                LOG_F(ERROR, "[headless] failed to render frame {}", i);
+                return exit_error;
+            }
+        }
+    }
+
+    print_stats(renderer().stats(), width, height);
+
+    int result = 0;
+    if (parser.isSet("stats")) {
+        std::ofstream out{parser.value("stats").toStdString()};
+        if (!out) {
+            LOG_F(ERROR, "[headless] failed to open '{}'", parser.value("stats").toStdString());
+            result = exit_error;
+        } else {
+            renderer().stats().write_csv(out);
+        }
+    }
+
+    if (parser.isSet("out") && !image.save(parser.value("out"))) {
+        LOG_F(ERROR, "[headless] failed to write '{}'", parser.value("out").toStdString());
+        result = exit_error;
+    }
+
+    if (parser.isSet("reference") && result == 0) {
+        QImage reference(parser.value("reference"));
+        if (reference.isNull()) {
+            LOG_F(ERROR, "[headless] failed to read reference '{}'", parser.value("reference").toStdString());
+            result = exit_error;
+        } else if (reference.size() != image.size()) {
+            LOG_F(ERROR, "[headless] reference is {}x{}, rendered {}x{}", reference.width(), reference.height(),
+                width, height);
+            result = exit_mismatch;
+        } else {
+            QImage diff;
+            auto cmp = compare_images(image, reference.convertToFormat(QImage::Format_RGBA8888),
+                parser.value("tolerance").toInt(), parser.isSet("diff") ? &diff : nullptr);
+            const double fraction = double(cmp.pixels) / (double(width) * double(height));
+            const bool pass = fraction <= parser.value("max-diff").toDouble();
+            std::printf("compare     %s, %lld pixels (%.4f%%) differ, max delta %d\n", pass ? "pass" : "FAIL",
+                static_cast<long long>(cmp.pixels), fraction * 100.0, cmp.max_delta);
+            if (parser.isSet("diff") && !diff.save(parser.value("diff"))) {
+                LOG_F(ERROR, "[headless] failed to write '{}'", parser.value("diff").toStdString());
+            }
+            if (!pass) { result = exit_mismatch; }
+        }
+    }
+
+    target.release();
+    scene.reset();
+    if (area) {
+        nw::kernel::objects().destroy(area->handle());
+    }
+    tracer().stop();
+
+    return result;
+}
@@ -0,0 +1,250 @@
+#include "fileio.h"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <system_error>
+
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+
+void set_error(std::string* error, std::string message)
+{
+    if (error) { *error = std::move(message); }
+}
+
+#if !defined(_WIN32)
+// Makes a rename durable, the new directory entry is otherwise only in memory.
+void sync_directory(const fs::path& dir)
+{
+    int fd = ::open(dir.empty() ? "." : dir.c_str(), O_RDONLY);
+    if (fd < 0) { return; }
+    ::fsync(fd);
+    ::close(fd);
+}
+#endif
+
+} // namespace
+
+// == Atomic Writes ===========================================================
+// ============================================================================
+
+fs::path temp_path(const fs::path& target)
+{
+    auto result = target;
+    result += ".tmp";
+    return result;
+}
+
+bool sync_file(const fs::path& path)
+{
+#if defined(_WIN32)
+    int fd = ::_wopen(path.c_str(), _O_RDWR | _O_BINARY);
+    if (fd < 0) { return false; }
+    bool result = ::_commit(fd) == 0;
+    ::_close(fd);
+#else
+    int fd = ::open(path.c_str(), O_WRONLY);
+    if (fd < 0) { return false; }
+    bool result = ::fsync(fd) == 0;
+    ::close(fd);
+#endif
+    return result;
+}
+
+bool replace_file(const fs::path& temp, const fs::path& target, std::string* error)
+{
+    std::error_code ec;
+    if (!sync_file(temp)) {
+        set_error(error, "failed to flush to disk");
+        fs::remove(temp, ec);
+        return false;
+    }
+
+    fs::rename(temp, target, ec);
+    if (ec) {
+        set_error(error, ec.message());
+        fs::remove(temp, ec);
+        return false;
+    }
+
+#if !defined(_WIN32)
+    sync_directory(target.parent_path());
+#endif
+    return true;
+}
+
+bool write_file_atomic(const fs::path& target, const FileWriterFn& writer, std::string* error)
+{
+    auto temp = temp_path(target);
+
+    bool written = false;
+    try {
+        written = writer(temp);
+        if (!written) { set_error(error, "failed to write"); }
+    } catch (const std::exception& e) {
+        set_error(error, e.what());
+    }
+
+    if (!written) {
+        std::error_code ec;
+        fs::remove(temp, ec);
+        return false;
+    }
+    return replace_file(temp, target, error);
+}
+
+bool write_file_atomic(const fs::path& target, const void* data, size_t size, std::string* error)
+{
+    return write_file_atomic(target, [data, size](const fs::path& temp) {
+        std::ofstream f{temp, std::ios::binary | std::ios::trunc};
+        return f && f.write(static_cast<const char*>(data), static_cast<std::streamsize>(size)) && f.flush();
+    }, error);
+}
+
+// == FileReader / FileWriter =================================================
+// ============================================================================
+
+#if defined(__linux__)
+
+FileReader::FileReader(const fs::path& path)
+    : fd_{::open(path.c_str(), O_RDONLY)}
+{
+}
+
+FileReader::~FileReader()
+{
+    if (fd_ >= 0) { ::close(fd_); }
+}
+
+bool FileReader::ok() const noexcept
+{
+    return fd_ >= 0;
+}
+
+FileWriter::FileWriter(const fs::path& path)
+    : fd_{::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)}
+{
+}
+
+FileWriter::~FileWriter()
+{
+    close();
+}
+
+bool FileWriter::ok() const noexcept
+{
+    return fd_ >= 0;
+}
+
+bool FileWriter::close()
+{
+    if (fd_ < 0) { return true; }
+    bool result = ::close(fd_) == 0;
+    fd_ = -1;
+    return result;
+}
+
+bool FileWriter::write(const void* data, size_t size)
+{
+    auto bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        auto n = ::write(fd_, bytes, size);
+        if (n <= 0) { return false; }
+        bytes += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool FileWriter::copy_from(FileReader& in, uint64_t offset, uint64_t size)
+{
+    loff_t off = static_cast<loff_t>(offset);
+    while (size > 0) {
+        auto n = ::copy_file_range(in.fd_, &off, fd_, nullptr, size, 0);
+        if (n <= 0) { break; }
+        size -= static_cast<uint64_t>(n);
+    }
+    if (size == 0) { return true; }
+
+    // Cross filesystem copies aren't supported by older kernels.
+    std::array<char, 1 << 16> buffer;
+    while (size > 0) {
+        auto n = ::pread(in.fd_, buffer.data(), std::min<uint64_t>(size, buffer.size()), off);
+        if (n <= 0 || !write(buffer.data(), static_cast<size_t>(n))) { return false; }
+        off += n;
+        size -= static_cast<uint64_t>(n);
+    }
+    return true;
+}
+
+#else
+
+FileReader::FileReader(const fs::path& path)
+    : f_{path, std::ios::binary}
+{
+}
+
+FileReader::~FileReader() = default;
+
+bool FileReader::ok() const noexcept
+{
+    return f_.good();
+}
+
+FileWriter::FileWriter(const fs::path& path)
+    : f_{path, std::ios::binary | std::ios::trunc}
+{
+}
+
+FileWriter::~FileWriter() = default;
+
+bool FileWriter::ok() const noexcept
+{
+    return f_.good();
+}
+
+bool FileWriter::close()
+{
+    if (!f_.is_open()) { return true; }
+    f_.close();
+    return !f_.fail();
+}
+
+bool FileWriter::write(const void* data, size_t size)
+{
+    f_.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    return f_.good();
+}
+
+bool FileWriter::copy_from(FileReader& in, uint64_t offset, uint64_t size)
+{
+    in.f_.clear();
+    in.f_.seekg(static_cast<std::streamoff>(offset));
+    std::array<char, 1 << 16> buffer;
+    while (size > 0 && in.f_) {
+        auto chunk = static_cast<std::streamsize>(std::min<uint64_t>(size, buffer.size()));
+        in.f_.read(buffer.data(), chunk);
+        f_.write(buffer.data(), in.f_.gcount());
+        size -= static_cast<uint64_t>(in.f_.gcount());
+    }
+    return size == 0 && f_.good();
+}
+
+#endif
+
+bool copy_file_region(const fs::path& from, uint64_t offset, uint64_t size, const fs::path& to)
+{
+    FileReader in{from};
+    FileWriter out{to};
+    return in.ok() && out.ok() && out.copy_from(in, offset, size) && out.close();
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string>
+
+// == Atomic Writes ===========================================================
+// ============================================================================
+
+/// Writes a file's contents to the given temporary path
+using FileWriterFn = std::function<bool(const std::filesystem::path& temp)>;
+
+/// Gets the path a file is written to before it replaces ``target``
+std::filesystem::path temp_path(const std::filesystem::path& target);
+
+/// Flushes a file's contents to disk
+bool sync_file(const std::filesystem::path& path);
+
+/// Syncs ``temp`` and renames it over ``target``, ``temp`` is removed on failure.
+///
+/// Without the sync, a crash shortly after the rename can leave ``target`` empty.
+bool replace_file(const std::filesystem::path& temp, const std::filesystem::path& target, std::string* error = nullptr);
+
+/// Writes ``target`` through ``writer`` into a temporary file that only replaces ``target`` if ``writer``
+/// succeeds, so readers see either the old or the new contents and never a partial file.
+bool write_file_atomic(const std::filesystem::path& target, const FileWriterFn& writer, std::string* error = nullptr);
+
+/// Writes ``size`` bytes of ``data`` to ``target`` atomically
+bool write_file_atomic(const std::filesystem::path& target, const void* data, size_t size, std::string* error = nullptr);
+
+// == FileReader / FileWriter =================================================
+// ============================================================================
+
+class FileWriter;
+
+/// Random access input that ``FileWriter`` copies regions from
+class FileReader {
+public:
+    explicit FileReader(const std::filesystem::path& path);
+    FileReader(const FileReader&) = delete;
+    FileReader& operator=(const FileReader&) = delete;
+    ~FileReader();
+
+    bool ok() const noexcept;
+
+private:
+    friend class FileWriter;
+#if defined(__linux__)
+    int fd_ = -1;
+#else
+    std::ifstream f_;
+#endif
+};
+
+/// Sequential output that copies regions of other files without passing them through user space where
+/// the platform allows, i.e. ``copy_file_range`` on Linux.
+class FileWriter {
+public:
+    /// Opens ``path`` for writing, truncating it
+    explicit FileWriter(const std::filesystem::path& path);
+    FileWriter(const FileWriter&) = delete;
+    FileWriter& operator=(const FileWriter&) = delete;
+    ~FileWriter();
+
+    bool ok() const noexcept;
+    bool close();
+    bool write(const void* data, size_t size);
+
+    /// Appends ``size`` bytes at ``offset`` in ``in``
+    bool copy_from(FileReader& in, uint64_t offset, uint64_t size);
+
+private:
+#if defined(__linux__)
+    int fd_ = -1;
+#else
+    std::ofstream f_;
+#endif
+};
+
+/// Copies ``size`` bytes at ``offset`` in ``from`` to the file ``to``, truncating it
+bool copy_file_region(const std::filesystem::path& from, uint64_t offset, uint64_t size, const std::filesystem::path& to);
@@ -0,0 +1,77 @@
+#include "DiskCache.hpp"
+
+#include "../fileio/fileio.h"
+
+#include <nw/log.hpp>
+
+#include <DiligentCore/Graphics/GraphicsEngine/interface/APIInfo.h>
+#include <DiligentCore/Graphics/GraphicsEngine/interface/RenderDevice.h>
+#include <xxhash/xxh3.h>
+
+#include <fstream>
+#include <string>
+
+namespace fs = std::filesystem;
+
+DiskCache::DiskCache(const fs::path& root, Diligent::IRenderDevice* device)
+{
+    if (root.empty() || !device) { return; }
+
+    const auto& info = device->GetDeviceInfo();
+    const auto& adapter = device->GetAdapterInfo();
+
+    XXH3_state_t* state = XXH3_createState();
+    XXH3_64bits_reset(state);
+    auto update = [state](const auto& value) { XXH3_64bits_update(state, &value, sizeof(value)); };
+    update(info.Type);
+    update(info.APIVersion.Major);
+    update(info.APIVersion.Minor);
+    update(adapter.VendorId);
+    update(adapter.DeviceId);
+    XXH3_64bits_update(state, adapter.Description, std::char_traits<char>::length(adapter.Description));
+    update(DILIGENT_API_VERSION);
+    auto key = XXH3_64bits_digest(state);
+    XXH3_freeState(state);
+
+    auto dir = root / fmt::format("{:016x}", key);
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+    if (ec) {
+        LOG_F(WARNING, "[renderer] disk cache disabled, failed to create '{}': {}", dir.string(), ec.message());
+        return;
+    }
+    dir_ = std::move(dir);
+    LOG_F(INFO, "[renderer] disk cache: '{}'", dir_.string());
+}
+
+std::vector<uint8_t> DiskCache::read(std::string_view name) const
+{
+    std::vector<uint8_t> result;
+    if (!enabled()) { return result; }
+
+    std::ifstream f{dir_ / name, std::ios::binary | std::ios::ate};
+    if (!f) { return result; }
+
+    auto size = f.tellg();
+    if (size <= 0) { return result; }
+    result.resize(static_cast<size_t>(size));
+    f.seekg(0);
+    if (!f.read(reinterpret_cast<char*>(result.data()), size)) {
+        result.clear();
+    }
+    return result;
+}
+
+bool DiskCache::write(std::string_view name, const void* data, size_t size) const
+{
+    if (!enabled() || !data || size == 0) { return false; }
+
+    // Atomic, so a crash never leaves a truncated blob behind.
+    auto path = dir_ / name;
+    std::string error;
+    if (!write_file_atomic(path, data, size, &error)) {
+        LOG_F(WARNING, "[renderer] failed to write cache entry '{}': {}", path.string(), error);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+namespace Diligent {
+struct IRenderDevice;
+} // namespace Diligent
+
+/// Caches renderer artifacts, i.e. shader bytecode and pipeline caches, on disk.
+///
+/// Entries live in a subdirectory named after a hash of the graphics API, adapter and engine version,
+/// so switching GPUs or drivers never feeds one device another's blobs. A default constructed cache
+/// is disabled, reads miss and writes are dropped.
+class DiskCache {
+public:
+    DiskCache() = default;
+    DiskCache(const std::filesystem::path& root, Diligent::IRenderDevice* device);
+
+    /// Gets if the cache directory exists and is writable
+    bool enabled() const noexcept { return !dir_.empty(); }
+
+    /// Gets the directory entries are stored in
+    const std::filesystem::path& directory() const noexcept { return dir_; }
+
+    /// Reads an entry, empty if missing
+    std::vector<uint8_t> read(std::string_view name) const;
+
+    /// Writes an entry, replacing any previous one atomically
+    bool write(std::string_view name, const void* data, size_t size) const;
+
+private:
+    std::filesystem::path dir_;
+};
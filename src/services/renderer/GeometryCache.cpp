@@ -0,0 +1,67 @@
+#include "GeometryCache.hpp"
+
+#include <algorithm>
+
+namespace {
+
+// Recently used entries kept alive after their last user is gone.
+constexpr size_t recent_model_count = 64;
+constexpr size_t recent_area_count = 2;
+
+// Moves ``value`` to the front of ``recent``, dropping the least recently used past ``limit``
+template <typename T>
+void touch(std::vector<std::shared_ptr<T>>& recent, const std::shared_ptr<T>& value, size_t limit)
+{
+    auto it = std::find(std::begin(recent), std::end(recent), value);
+    if (it == std::end(recent)) {
+        if (recent.size() < limit) {
+            recent.push_back(value);
+        } else {
+            recent.back() = value;
+        }
+        it = std::prev(std::end(recent));
+    }
+    std::rotate(std::begin(recent), it, std::next(it));
+}
+
+template <typename K, typename T>
+std::shared_ptr<T> lookup(absl::flat_hash_map<K, std::weak_ptr<T>>& map, const K& key,
+    std::vector<std::shared_ptr<T>>& recent, size_t limit)
+{
+    auto it = map.find(key);
+    std::shared_ptr<T> result = it != std::end(map) ? it->second.lock() : nullptr;
+    if (!result) {
+        // Entries only expire once out of ``recent``, so misses are a good time to drop them.
+        for (auto e = std::begin(map); e != std::end(map);) {
+            if (e->second.expired()) {
+                map.erase(e++);
+            } else {
+                ++e;
+            }
+        }
+        result = std::make_shared<T>();
+        map[key] = result;
+    }
+    touch(recent, result, limit);
+    return result;
+}
+
+} // namespace
+
+std::shared_ptr<ModelGeometry> GeometryCache::get(std::string_view resref)
+{
+    return lookup(map_, nw::Resref{resref}, recent_models_, recent_model_count);
+}
+
+std::shared_ptr<AreaGeometry> GeometryCache::get_area(std::string_view key)
+{
+    return lookup(areas_, std::string(key), recent_areas_, recent_area_count);
+}
+
+void GeometryCache::clear()
+{
+    recent_models_.clear();
+    recent_areas_.clear();
+    map_.clear();
+    areas_.clear();
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <nw/resources/Resref.hpp>
+
+#include <DiligentCore/Common/interface/RefCntAutoPtr.hpp>
+#include <DiligentCore/Graphics/GraphicsEngine/interface/Buffer.h>
+#include <absl/container/flat_hash_map.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// Immutable GPU geometry of a single mesh node
+struct MeshGeometry {
+    Diligent::RefCntAutoPtr<Diligent::IBuffer> vertices;
+    Diligent::RefCntAutoPtr<Diligent::IBuffer> indices;
+};
+
+/// GPU geometry of every mesh in a model, shared by all instances of that model
+struct ModelGeometry {
+    /// Keyed by the mesh's index in ``Model::nodes_``, node addresses don't outlive a module
+    absl::flat_hash_map<int32_t, MeshGeometry> meshes;
+};
+
+/// A run of a baked chunk's indices drawn with a single texture
+struct ChunkBatch {
+    uint32_t texture = 0; ///< Index into ``AreaGeometry::textures``
+    uint32_t first_index = 0;
+    uint32_t index_count = 0;
+};
+
+/// Static tile meshes of a block of tiles, pre-transformed into area space and merged into one
+/// vertex buffer and one 32-bit index buffer, with indices grouped by texture
+struct AreaChunk {
+    Diligent::RefCntAutoPtr<Diligent::IBuffer> vertices;
+    Diligent::RefCntAutoPtr<Diligent::IBuffer> indices;
+    std::vector<ChunkBatch> batches;
+};
+
+/// Baked static geometry of an area's tiles
+struct AreaGeometry {
+    std::vector<AreaChunk> chunks;
+    /// Texture slots belong to whoever loaded them, so batches refer to textures by resref
+    std::vector<nw::Resref> textures;
+    bool baked = false;
+};
+
+/// Caches model geometry by resref.
+///
+/// Entries live as long as at least one ``Model`` holds them or they are among the most recently
+/// used, so switching back and forth between views doesn't re-upload.  Per instance state,
+/// i.e. transforms, animation, and constant buffers, stays with the ``Model``.
+class GeometryCache {
+public:
+    /// Gets geometry for ``resref``, an empty entry is created on first use
+    std::shared_ptr<ModelGeometry> get(std::string_view resref);
+
+    /// Gets baked area geometry for ``key``, an empty entry is created on first use
+    std::shared_ptr<AreaGeometry> get_area(std::string_view key);
+
+    /// Drops all entries not held by a ``Model``, i.e. when a module is unloaded
+    void clear();
+
+private:
+    absl::flat_hash_map<nw::Resref, std::weak_ptr<ModelGeometry>> map_;
+    absl::flat_hash_map<std::string, std::weak_ptr<AreaGeometry>> areas_;
+    std::vector<std::shared_ptr<ModelGeometry>> recent_models_; ///< Most recently used first
+    std::vector<std::shared_ptr<AreaGeometry>> recent_areas_;   ///< Most recently used first
+};
@@ -3,6 +3,8 @@
 #include "placeholder_texture.h"
 #include "renderservice.h"
 
+#include "../trace/trace.h"
+
 #include <nw/kernel/Resources.hpp>
 
 #include <DiligentCore/Graphics/GraphicsTools/interface/GraphicsUtilities.h>
@@ -10,6 +12,7 @@
 
 std::pair<Diligent::RefCntAutoPtr<Diligent::ITexture>, bool> load_texture(std::string_view resref)
 {
+    TRACE_SCOPE_ARG("load_texture", std::string(resref));
     Diligent::RefCntAutoPtr<Diligent::ITexture> texture;
     if (resref == "null") { return {texture, false}; }
 
@@ -70,6 +73,7 @@ std::pair<Diligent::RefCntAutoPtr<Diligent::ITexture>, bool> load_texture(std::s
         TexData.NumSubresources = 1;
 
         renderer().device()->CreateTexture(TexDesc, &TexData, &texture);
+        if (texture) { renderer().stats().texture_upload(uint64_t(SubResData.Stride) * TexDesc.Height); }
         return {texture, false};
     } else {
         nw::Plt plt{std::move(data)};
@@ -96,6 +100,7 @@ std::pair<Diligent::RefCntAutoPtr<Diligent::ITexture>, bool> load_texture(std::s
         TexData.NumSubresources = 1;
 
         renderer().device()->CreateTexture(TexDesc, &TexData, &texture);
+        if (texture) { renderer().stats().texture_upload(uint64_t(SubResData.Stride) * TexDesc.Height); }
         return {texture, true};
     }
 }
@@ -105,6 +110,7 @@ TextureCache::TextureCache(uint32_t max_textures)
 {
     texture_views.resize(max_texture_id_);
     id_to_resref_.resize(max_texture_id_);
+    dirty_slots_.resize(max_texture_id_);
     map_.reserve(max_texture_id_);
 }
 
@@ -113,9 +119,33 @@ bool TextureCache::dirty() const noexcept
     return is_dirty_;
 }
 
-void TextureCache::set_dirty(bool dirty)
+void TextureCache::mark_dirty(uint32_t slot)
+{
+    if (slot >= dirty_slots_.size()) { return; }
+    dirty_slots_[slot] = true;
+    is_dirty_ = true;
+}
+
+std::vector<std::pair<uint32_t, uint32_t>> TextureCache::take_dirty_ranges()
 {
-    is_dirty_ = dirty;
+    std::vector<std::pair<uint32_t, uint32_t>> result;
+    if (!is_dirty_) { return result; }
+
+    const auto size = static_cast<uint32_t>(dirty_slots_.size());
+    for (uint32_t i = 0; i < size;) {
+        if (!dirty_slots_[i]) {
+            ++i;
+            continue;
+        }
+        uint32_t first = i;
+        while (i < size && dirty_slots_[i]) {
+            dirty_slots_[i] = false;
+            ++i;
+        }
+        result.emplace_back(first, i - first);
+    }
+    is_dirty_ = false;
+    return result;
 }
 
 std::pair<TextureID, bool> TextureCache::load(std::string_view resref)
@@ -132,7 +162,7 @@ std::pair<TextureID, bool> TextureCache::load(std::string_view resref)
         texture_views[tex.id] = texture->GetDefaultView(Diligent::TEXTURE_VIEW_SHADER_RESOURCE);
         id_to_resref_[tex.id] = resref;
         map_.emplace(resref, TexturePayload{tex, texture, is_plt, 1});
-        is_dirty_ = true;
+        mark_dirty(tex.id);
         return {tex, is_plt};
     } else {
         ++it->second.refcount_;
@@ -190,10 +220,11 @@ void TextureCache::load_palette_texture()
 
         Diligent::RefCntAutoPtr<Diligent::ITexture> texture;
         renderer().device()->CreateTexture(TexDesc, &TexData, &texture);
+        if (texture) { renderer().stats().texture_upload(uint64_t(SubResData.Stride) * TexDesc.Height); }
         palette_texture_[i] = texture;
 
         texture_views[tex.id] = texture->GetDefaultView(Diligent::TEXTURE_VIEW_SHADER_RESOURCE);
-        is_dirty_ = true;
+        mark_dirty(tex.id);
         id_to_resref_[tex.id] = name;
         map_.insert({name,
             TexturePayload{
@@ -246,10 +277,10 @@ void TextureCache::load_placeholder()
             }});
 
         // Set all texture view to placeholder.
-        for (uint32_t i = 1; i < max_texture_id_; ++i) {
+        for (uint32_t i = 0; i < max_texture_id_; ++i) {
             texture_views[i] = texture_views[tex.id];
+            mark_dirty(i);
         }
-        is_dirty_ = true;
     }
 }
 
@@ -316,7 +347,7 @@ void TextureCache::release(TextureID tex)
     if (--it->second.refcount_ == 0) {
         id_to_resref_[tex.id] = std::string_view{};
         texture_views[tex.id] = texture_views[0];
-        is_dirty_ = true;
+        mark_dirty(tex.id);
         map_.erase(it);
         texture_id_free_list_.push_back(tex);
     }
@@ -13,6 +13,9 @@ struct TextureID {
     uint32_t id = 0;
 };
 
+/// Loads and uploads a texture, the second member is true if it's a PLT
+std::pair<Diligent::RefCntAutoPtr<Diligent::ITexture>, bool> load_texture(std::string_view resref);
+
 class TextureCache {
 public:
     TextureCache(uint32_t max_textures);
@@ -26,8 +29,14 @@ public:
     Diligent::RefCntAutoPtr<Diligent::ISampler> aniso_sampler;
     Diligent::RefCntAutoPtr<Diligent::ISampler> shadow_sampler;
 
+    /// Gets if any texture slot changed since the last ``take_dirty_ranges``
     bool dirty() const noexcept;
-    void set_dirty(bool dirty);
+
+    /// Marks a texture slot as needing its descriptor rewritten
+    void mark_dirty(uint32_t slot);
+
+    /// Gets changed slots as contiguous ``[first, first + count)`` runs and clears them
+    std::vector<std::pair<uint32_t, uint32_t>> take_dirty_ranges();
 
     void load_palette_texture();
     void load_placeholder();
@@ -56,5 +65,6 @@ private:
     absl::flat_hash_map<nw::Resref, TexturePayload> map_;
 
     std::vector<nw::Resref> id_to_resref_;
+    std::vector<bool> dirty_slots_;
     bool is_dirty_ = false;
 };
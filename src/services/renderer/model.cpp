@@ -1,6 +1,7 @@
 #include "model.hpp"
 
 #include "../../services/renderer/renderservice.h"
+#include "../trace/trace.h"
 
 #include <nw/formats/Tileset.hpp>
 #include <nw/kernel/ModelCache.hpp>
@@ -12,6 +13,10 @@
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtx/quaternion.hpp>
 #include <glm/gtx/string_cast.hpp>
+#include <xxhash/xxh3.h>
+
+#include <algorithm>
+#include <map>
 
 void Node::draw(RenderContext& ctx, const glm::mat4x4& mtx)
 {
@@ -29,6 +34,14 @@ void Node::draw(RenderContext& ctx, const glm::mat4x4& mtx)
     }
 }
 
+glm::mat4 Node::local_transform() const
+{
+    if (!has_transform_) { return glm::mat4{1.0f}; }
+    auto trans = glm::translate(glm::mat4{1.0f}, position_);
+    trans = trans * glm::toMat4(rotation_);
+    return glm::scale(trans, scale_);
+}
+
 glm::mat4 Node::get_transform() const
 {
     auto parent = glm::mat4{1.0f};
@@ -52,13 +65,18 @@ Mesh::~Mesh()
     renderer().textures().release(texture0);
 }
 
-void Mesh::draw(RenderContext& ctx, const glm::mat4x4& mtx)
+glm::mat4 Mesh::local_transform() const
 {
-    auto trans = glm::translate(mtx, position_);
+    auto trans = glm::translate(glm::mat4{1.0f}, position_);
     trans = trans * glm::toMat4(rotation_);
-    trans = glm::scale(trans, scale_);
+    return glm::scale(trans, scale_);
+}
+
+void Mesh::submit(RenderContext& ctx, const glm::mat4x4& mtx)
+{
+    auto trans = mtx * owner_->pose_[index_];
 
-    if (!no_render_) {
+    if (!no_render_ && !baked_) {
         // LOG_F(INFO, "view matrix: {}", glm::to_string(ctx.view));
         // LOG_F(INFO, "projection matrix: {}", glm::to_string(ctx.projection));
         // LOG_F(INFO, "model transform matrix: {}", glm::to_string(trans));
@@ -91,8 +109,7 @@ void Mesh::draw(RenderContext& ctx, const glm::mat4x4& mtx)
             LOG_F(ERROR, "Constant buffer is null");
         }
 
-        renderer().immediate_context()->SetPipelineState(pso);
-        renderer().immediate_context()->CommitShaderResources(srb, Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        renderer().bind_pipeline(pso, srb);
 
         Diligent::Uint64 offsets[] = {0};
         Diligent::IBuffer* vertex_buffers[] = {vertices};
@@ -105,10 +122,7 @@ void Mesh::draw(RenderContext& ctx, const glm::mat4x4& mtx)
         draw_attrs.NumIndices = static_cast<uint32_t>(orig->indices.size());
         draw_attrs.Flags = Diligent::DRAW_FLAG_VERIFY_ALL;
         renderer().immediate_context()->DrawIndexed(draw_attrs);
-    }
-
-    for (auto child : children_) {
-        child->draw(ctx, trans);
+        renderer().stats().draw(draw_attrs.NumIndices);
     }
 }
 
@@ -147,23 +161,21 @@ void Skin::build_inverse_binds()
     build_inverse_bind_array(this, parent, glm::inverse(trans), inverse_bind_pose_);
 }
 
-void Skin::draw(RenderContext& ctx, const glm::mat4x4& mtx)
+void Skin::submit(RenderContext& ctx, const glm::mat4x4& mtx)
 {
     auto orig = static_cast<nw::model::SkinNode*>(orig_);
+    const auto& pose = owner_->pose_;
 
     for (size_t i = 0; i < 64; ++i) {
-        if (orig->bone_nodes[i] <= 0 || size_t(orig->bone_nodes[i]) >= owner_->nodes_.size()) {
+        if (orig->bone_nodes[i] <= 0 || size_t(orig->bone_nodes[i]) >= pose.size()) {
             break;
         }
-
-        auto bone_node = owner_->nodes_[orig->bone_nodes[i]].get();
-
-        joints.data[i] = bone_node->get_transform() * inverse_bind_pose_[orig->bone_nodes[i]];
+        joints.data[i] = pose[orig->bone_nodes[i]] * inverse_bind_pose_[orig->bone_nodes[i]];
     }
 
     uniforms.projection = ctx.projection;
     uniforms.view = ctx.view;
-    uniforms.model = mtx; // [NOTE] Model transform is already included!
+    uniforms.model = parent_ ? mtx * pose[parent_->index_] : mtx; // [NOTE] Joints are in model space
     uniforms.texture = texture0.id;
     {
         Diligent::MapHelper<SkinConstants> constants(renderer().immediate_context(), constant_buffer, Diligent::MAP_WRITE, Diligent::MAP_FLAG_DISCARD);
@@ -197,8 +209,7 @@ void Skin::draw(RenderContext& ctx, const glm::mat4x4& mtx)
         LOG_F(ERROR, "Joint constant buffer is null");
     }
 
-    renderer().immediate_context()->SetPipelineState(pso);
-    renderer().immediate_context()->CommitShaderResources(srb, Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    renderer().bind_pipeline(pso, srb);
 
     Diligent::Uint64 offsets[] = {0};
     Diligent::IBuffer* vertex_buffers[] = {vertices};
@@ -210,11 +221,7 @@ void Skin::draw(RenderContext& ctx, const glm::mat4x4& mtx)
     draw_attrs.NumIndices = static_cast<uint32_t>(orig->indices.size());
     draw_attrs.Flags = Diligent::DRAW_FLAG_VERIFY_ALL;
     renderer().immediate_context()->DrawIndexed(draw_attrs);
-
-    // Draw children
-    for (auto child : children_) {
-        child->draw(ctx, mtx);
-    }
+    renderer().stats().draw(draw_attrs.NumIndices);
 }
 
 // == Model ===================================================================
@@ -222,7 +229,21 @@ void Skin::draw(RenderContext& ctx, const glm::mat4x4& mtx)
 
 void Model::draw(RenderContext& ctx, const glm::mat4x4& mtx)
 {
-    nodes_[0]->draw(ctx, mtx);
+    if (pose_dirty_) { update_pose(); }
+    for (const auto& node : nodes_) {
+        node->submit(ctx, mtx);
+    }
+}
+
+void Model::update_pose()
+{
+    pose_.resize(nodes_.size());
+    for (size_t i = 0; i < nodes_.size(); ++i) {
+        const auto* node = nodes_[i].get();
+        auto local = node->local_transform();
+        pose_[i] = node->parent_ ? pose_[node->parent_->index_] * local : local;
+    }
+    pose_dirty_ = false;
 }
 
 Node* Model::find(std::string_view name)
@@ -254,6 +275,7 @@ bool Model::load(nw::model::Model* mdl)
         return false;
     }
     mdl_ = mdl;
+    geometry_ = renderer().geometry().get(mdl->name);
     if (load_node(root)) {
         for (auto& node : nodes_) {
             node->owner_ = this;
@@ -268,6 +290,7 @@ bool Model::load(nw::model::Model* mdl)
 bool Model::load_animation(std::string_view anim)
 {
     anim_ = nullptr;
+    anim_targets_.clear();
     nw::model::Model* m = mdl_;
     while (m) {
         for (const auto& it : m->animations) {
@@ -281,10 +304,52 @@ bool Model::load_animation(std::string_view anim)
     }
     if (anim_) {
         LOG_F(INFO, "Loaded animation: {} from model: {}", anim, m->name);
+        anim_targets_.reserve(anim_->nodes.size());
+        for (const auto& it : anim_->nodes) {
+            anim_targets_.push_back(find(it->name));
+        }
     }
     return !!anim_;
 }
 
+MeshGeometry Model::mesh_geometry(int32_t index, const void* vertices, size_t vertices_size,
+    const uint16_t* indices, size_t indices_count, std::string_view kind)
+{
+    auto it = geometry_->meshes.find(index);
+    if (it != std::end(geometry_->meshes)) {
+        return it->second;
+    }
+
+    MeshGeometry result;
+    auto vb_name = fmt::format("{} Vertex Buffer", kind);
+    auto ib_name = fmt::format("{} Index Buffer", kind);
+
+    Diligent::BufferDesc vertexBufferDesc;
+    vertexBufferDesc.Name = vb_name.c_str();
+    vertexBufferDesc.Usage = Diligent::USAGE_IMMUTABLE;
+    vertexBufferDesc.BindFlags = Diligent::BIND_VERTEX_BUFFER;
+    vertexBufferDesc.Size = vertices_size;
+
+    Diligent::BufferData vertexBufferData;
+    vertexBufferData.pData = vertices;
+    vertexBufferData.DataSize = vertexBufferDesc.Size;
+    renderer().device()->CreateBuffer(vertexBufferDesc, &vertexBufferData, &result.vertices);
+
+    Diligent::BufferDesc indexBufferDesc;
+    indexBufferDesc.Name = ib_name.c_str();
+    indexBufferDesc.Usage = Diligent::USAGE_IMMUTABLE;
+    indexBufferDesc.BindFlags = Diligent::BIND_INDEX_BUFFER;
+    indexBufferDesc.Size = indices_count * sizeof(uint16_t);
+
+    Diligent::BufferData indexBufferData;
+    indexBufferData.pData = indices;
+    indexBufferData.DataSize = indexBufferDesc.Size;
+    renderer().device()->CreateBuffer(indexBufferDesc, &indexBufferData, &result.indices);
+
+    geometry_->meshes.emplace(index, result);
+    return result;
+}
+
 Node* Model::load_node(nw::model::Node* node, Node* parent)
 {
     Node* result = nullptr;
@@ -296,27 +361,10 @@ Node* Model::load_node(nw::model::Node* node, Node* parent)
             skin->rps_.has_diffuse = true;
             auto [pso, srb] = renderer().get_pso(rps_);
 
-            // Create vertex buffer
-            Diligent::BufferDesc VBDesc;
-            VBDesc.Name = "Skin Vertex Buffer";
-            VBDesc.Usage = Diligent::USAGE_IMMUTABLE;
-            VBDesc.BindFlags = Diligent::BIND_VERTEX_BUFFER;
-            VBDesc.Size = n->vertices.size() * sizeof(nw::model::SkinVertex);
-            Diligent::BufferData VBData;
-            VBData.pData = n->vertices.data();
-            VBData.DataSize = VBDesc.Size;
-            renderer().device()->CreateBuffer(VBDesc, &VBData, &skin->vertices);
-
-            // Create index buffer
-            Diligent::BufferDesc IBDesc;
-            IBDesc.Name = "Skin Index Buffer";
-            IBDesc.Usage = Diligent::USAGE_IMMUTABLE;
-            IBDesc.BindFlags = Diligent::BIND_INDEX_BUFFER;
-            IBDesc.Size = n->indices.size() * sizeof(uint16_t);
-            Diligent::BufferData IBData;
-            IBData.pData = n->indices.data();
-            IBData.DataSize = IBDesc.Size;
-            renderer().device()->CreateBuffer(IBDesc, &IBData, &skin->indices);
+            auto geom = mesh_geometry(int32_t(nodes_.size()), n->vertices.data(),
+                n->vertices.size() * sizeof(nw::model::SkinVertex), n->indices.data(), n->indices.size(), "Skin");
+            skin->vertices = geom.vertices;
+            skin->indices = geom.indices;
 
             auto [tex, is_plt] = renderer().textures().load(n->bitmap);
 
@@ -361,31 +409,10 @@ Node* Model::load_node(nw::model::Node* node, Node* parent)
             mesh->no_render_ = !n->render;
             mesh->rps_.has_diffuse = true;
 
-            // Vertex Buffer Creation
-            Diligent::BufferDesc vertexBufferDesc;
-            vertexBufferDesc.Name = "Vertex Buffer";
-            vertexBufferDesc.Usage = Diligent::USAGE_IMMUTABLE;
-            vertexBufferDesc.BindFlags = Diligent::BIND_VERTEX_BUFFER;
-            vertexBufferDesc.Size = n->vertices.size() * sizeof(nw::model::Vertex);
-
-            Diligent::BufferData vertexBufferData;
-            vertexBufferData.pData = n->vertices.data();
-            vertexBufferData.DataSize = vertexBufferDesc.Size;
-
-            renderer().device()->CreateBuffer(vertexBufferDesc, &vertexBufferData, &mesh->vertices);
-
-            // Index Buffer Creation
-            Diligent::BufferDesc indexBufferDesc;
-            indexBufferDesc.Name = "Index Buffer";
-            indexBufferDesc.Usage = Diligent::USAGE_IMMUTABLE;
-            indexBufferDesc.BindFlags = Diligent::BIND_INDEX_BUFFER;
-            indexBufferDesc.Size = n->indices.size() * sizeof(uint16_t);
-
-            Diligent::BufferData indexBufferData;
-            indexBufferData.pData = n->indices.data();
-            indexBufferData.DataSize = indexBufferDesc.Size;
-
-            renderer().device()->CreateBuffer(indexBufferDesc, &indexBufferData, &mesh->indices);
+            auto geom = mesh_geometry(int32_t(nodes_.size()), n->vertices.data(),
+                n->vertices.size() * sizeof(nw::model::Vertex), n->indices.data(), n->indices.size(), "Mesh");
+            mesh->vertices = geom.vertices;
+            mesh->indices = geom.indices;
 
             // Texture Creation
             auto [tex, is_plt] = renderer().textures().load(n->bitmap);
@@ -418,6 +445,7 @@ Node* Model::load_node(nw::model::Node* node, Node* parent)
 
     result->parent_ = parent;
     result->orig_ = node;
+    result->index_ = static_cast<int32_t>(nodes_.size());
 
     auto key = node->get_controller(nw::model::ControllerType::Position);
     if (key.data.size()) {
@@ -454,9 +482,11 @@ void Model::update(int32_t dt)
     }
 
     float time_ms = static_cast<float>(anim_cursor_);
+    pose_dirty_ = true;
 
-    for (const auto& anim : anim_->nodes) {
-        auto node = find(anim->name);
+    for (size_t n = 0; n < anim_->nodes.size(); ++n) {
+        const auto& anim = anim_->nodes[n];
+        auto node = anim_targets_[n];
         if (!node) { continue; }
 
         auto poskey = anim->get_controller(nw::model::ControllerType::Position, true);
@@ -575,6 +605,7 @@ void Model::update(int32_t dt)
 
 std::unique_ptr<Model> load_model(std::string_view resref)
 {
+    TRACE_SCOPE_ARG("load_model", std::string(resref));
     auto model = nw::kernel::models().load(resref);
     if (!model) { return {}; }
 
@@ -589,6 +620,56 @@ std::unique_ptr<Model> load_model(std::string_view resref)
 // == BasicTileArea ===========================================================
 // ============================================================================
 
+namespace {
+
+glm::mat4 tile_transform(const glm::mat4& mtx, const Model* tile)
+{
+    auto trans = glm::translate(mtx, tile->position_);
+    trans = trans * glm::toMat4(tile->rotation_);
+    return glm::scale(trans, tile->scale_);
+}
+
+// True if an animation node has transform keys, animations list every node, including ones they don't move
+bool has_transform_keys(const nw::model::Node* node)
+{
+    for (auto type : {nw::model::ControllerType::Position, nw::model::ControllerType::Orientation,
+             nw::model::ControllerType::Scale}) {
+        if (node->get_controller(type, true).time.size() > 0) { return true; }
+    }
+    return false;
+}
+
+// Flags nodes that an animation of ``model``, or of its supermodels, could move, directly or through a parent
+std::vector<bool> movable_nodes(Model* model)
+{
+    std::vector<bool> result(model->nodes_.size(), model->animating());
+    if (model->animating()) { return result; }
+
+    const nw::model::Model* m = model->mdl_;
+    while (m) {
+        for (const auto& anim : m->animations) {
+            for (const auto& it : anim->nodes) {
+                if (!has_transform_keys(it.get())) { continue; }
+                if (auto node = model->find(it->name)) {
+                    result[node->index_] = true;
+                }
+            }
+        }
+        if (!m->supermodel) { break; }
+        m = &m->supermodel->model;
+    }
+
+    // ``nodes_`` is ordered parent before child
+    for (const auto& node : model->nodes_) {
+        if (node->parent_ && result[node->parent_->index_]) {
+            result[node->index_] = true;
+        }
+    }
+    return result;
+}
+
+} // namespace
+
 BasicTileArea::BasicTileArea(nw::Area* area)
     : area_{area}
 {
@@ -597,20 +678,72 @@ BasicTileArea::BasicTileArea(nw::Area* area)
 void BasicTileArea::draw(RenderContext& ctx, const glm::mat4x4& mtx)
 {
     for (const auto& tile : tile_models_) {
-        auto trans = glm::translate(mtx, tile->position_);
-        trans = trans * glm::toMat4(tile->rotation_);
-        trans = glm::scale(trans, tile->scale_);
-        tile->draw(ctx, trans);
+        if (!tile) { continue; }
+        tile->draw(ctx, tile_transform(mtx, tile.get()));
+    }
+    draw_chunks(ctx, mtx);
+}
+
+void BasicTileArea::draw_chunks(RenderContext& ctx, const glm::mat4& mtx)
+{
+    if (!chunks_ || !constant_buffer_) { return; }
+
+    RenderPipelineState rps;
+    rps.has_diffuse = true;
+    auto [pso, srb] = renderer().get_pso(rps);
+    if (!pso || !srb) {
+        LOG_F(ERROR, "Invalid PSO for area chunks");
+        return;
+    }
+    srb->GetVariableByName(Diligent::SHADER_TYPE_VERTEX, "Constants")->Set(constant_buffer_);
+
+    auto* ic = renderer().immediate_context();
+    for (const auto& chunk : chunks_->chunks) {
+        if (!chunk.vertices || !chunk.indices) { continue; }
+
+        Diligent::Uint64 offsets[] = {0};
+        Diligent::IBuffer* vertex_buffers[] = {chunk.vertices};
+        ic->SetVertexBuffers(0, 1, vertex_buffers, offsets, Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION, Diligent::SET_VERTEX_BUFFERS_FLAG_RESET);
+        ic->SetIndexBuffer(chunk.indices, 0, Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        for (const auto& batch : chunk.batches) {
+            {
+                Diligent::MapHelper<MeshConstants> constants(ic, constant_buffer_, Diligent::MAP_WRITE, Diligent::MAP_FLAG_DISCARD);
+                if (!constants) {
+                    LOG_F(ERROR, "Failed to map constant buffer for area chunk");
+                    return;
+                }
+                constants->model = mtx; // [NOTE] Vertices are baked in area space
+                constants->view = ctx.view;
+                constants->projection = ctx.projection;
+                constants->texture = chunk_textures_[batch.texture];
+            }
+
+            renderer().bind_pipeline(pso, srb);
+
+            Diligent::DrawIndexedAttribs draw_attrs;
+            draw_attrs.IndexType = Diligent::VT_UINT32;
+            draw_attrs.NumIndices = batch.index_count;
+            draw_attrs.FirstIndexLocation = batch.first_index;
+            draw_attrs.Flags = Diligent::DRAW_FLAG_VERIFY_ALL;
+            ic->DrawIndexed(draw_attrs);
+            renderer().stats().draw(draw_attrs.NumIndices);
+        }
     }
 }
 
 void BasicTileArea::load_tile_models()
 {
+    TRACE_SCOPE_ARG("BasicTileArea::load_tile_models", fmt::format("{} tiles", area_->width * area_->height));
     for (size_t h = 0; h < static_cast<size_t>(area_->height); ++h) {
         for (size_t w = 0; w < static_cast<size_t>(area_->width); ++w) {
             auto idx = h * area_->width + w;
             const auto& at = area_->tiles[idx];
             auto mdl = load_model(area_->tileset->tiles.at(at.id).model);
+            if (!mdl) {
+                tile_models_.push_back(nullptr);
+                continue;
+            }
 
             auto x = w * 10.0f + 5.0f;
             auto y = h * 10.0f + 5.0f;
@@ -621,11 +754,165 @@ void BasicTileArea::load_tile_models()
             tile_models_.push_back(std::move(mdl));
         }
     }
+
+    bake_static_geometry();
+}
+
+void BasicTileArea::bake_static_geometry()
+{
+    TRACE_SCOPE("BasicTileArea::bake_static_geometry");
+
+    const size_t width = static_cast<size_t>(area_->width);
+    const size_t height = static_cast<size_t>(area_->height);
+    const size_t chunks_x = (width + chunk_size - 1) / chunk_size;
+    const size_t chunks_y = (height + chunk_size - 1) / chunk_size;
+
+    // The bake only depends on the tileset and tile layout, so areas are keyed by both and
+    // an edited layout never picks up a stale bake.
+    XXH3_state_t* state = XXH3_createState();
+    XXH3_64bits_reset(state);
+    for (const auto& tile : area_->tiles) {
+        XXH3_64bits_update(state, &tile.id, sizeof(tile.id));
+        XXH3_64bits_update(state, &tile.height, sizeof(tile.height));
+        XXH3_64bits_update(state, &tile.orientation, sizeof(tile.orientation));
+    }
+    auto layout = XXH3_64bits_digest(state);
+    XXH3_freeState(state);
+
+    chunks_ = renderer().geometry().get_area(fmt::format("{}:{}:{}x{}:{:016x}", area_->common.resref.view(),
+        area_->tileset_resref.view(), width, height, layout));
+    const bool cached = chunks_->baked;
+    if (!cached) {
+        chunks_->chunks.resize(chunks_x * chunks_y);
+    }
+
+    // A cached bake may have been made by another instance whose tile models, and their texture
+    // slots, are gone, so slots are resolved from this instance's meshes.
+    absl::flat_hash_map<nw::Resref, uint32_t> texture_index;
+    for (const auto& resref : chunks_->textures) {
+        texture_index.emplace(resref, uint32_t(texture_index.size()));
+    }
+    chunk_textures_.assign(chunks_->textures.size(), 0);
+
+    size_t baked_meshes = 0;
+    for (size_t cy = 0; cy < chunks_y; ++cy) {
+        for (size_t cx = 0; cx < chunks_x; ++cx) {
+            // Ordered by texture index so batches are laid out deterministically
+            std::map<uint32_t, std::pair<std::vector<nw::model::Vertex>, std::vector<uint32_t>>> groups;
+
+            for (size_t h = cy * chunk_size; h < std::min(height, (cy + 1) * chunk_size); ++h) {
+                for (size_t w = cx * chunk_size; w < std::min(width, (cx + 1) * chunk_size); ++w) {
+                    auto tile = tile_models_[h * width + w].get();
+                    if (!tile) { continue; }
+                    if (tile->pose_dirty_) { tile->update_pose(); }
+
+                    auto movable = movable_nodes(tile);
+                    auto tile_mtx = tile_transform(glm::mat4{1.0f}, tile);
+                    for (const auto& node : tile->nodes_) {
+                        auto mesh = dynamic_cast<Mesh*>(node.get());
+                        if (!mesh || mesh->no_render_ || movable[mesh->index_]) { continue; }
+
+                        auto orig = static_cast<nw::model::TrimeshNode*>(mesh->orig_);
+                        auto [it, added] = texture_index.emplace(nw::Resref{orig->bitmap},
+                            uint32_t(texture_index.size()));
+                        if (added) {
+                            chunks_->textures.push_back(it->first);
+                            chunk_textures_.push_back(0);
+                        }
+                        chunk_textures_[it->second] = mesh->texture0.id;
+
+                        mesh->baked_ = true;
+                        ++baked_meshes;
+                        if (cached) { continue; }
+
+                        auto trans = tile_mtx * tile->pose_[mesh->index_];
+                        auto normal_mtx = glm::mat3(glm::transpose(glm::inverse(trans)));
+                        auto& [vertices, indices] = groups[it->second];
+
+                        auto base = static_cast<uint32_t>(vertices.size());
+                        for (auto vertex : orig->vertices) {
+                            vertex.position = glm::vec3(trans * glm::vec4(vertex.position, 1.0f));
+                            vertex.normal = glm::normalize(normal_mtx * vertex.normal);
+                            auto tangent = glm::normalize(glm::mat3(trans) * glm::vec3(vertex.tangent));
+                            vertex.tangent = glm::vec4(tangent, vertex.tangent.w);
+                            vertices.push_back(vertex);
+                        }
+                        for (auto index : orig->indices) {
+                            indices.push_back(base + index);
+                        }
+                    }
+                }
+            }
+
+            if (cached || groups.empty()) { continue; }
+
+            // Batches share one vertex buffer, so indices are rebased as they're merged
+            auto& chunk = chunks_->chunks[cy * chunks_x + cx];
+            std::vector<nw::model::Vertex> vertices;
+            std::vector<uint32_t> indices;
+            for (auto& [texture, group] : groups) {
+                auto base = static_cast<uint32_t>(vertices.size());
+                chunk.batches.push_back({texture, static_cast<uint32_t>(indices.size()),
+                    static_cast<uint32_t>(group.second.size())});
+                vertices.insert(std::end(vertices), std::begin(group.first), std::end(group.first));
+                for (auto index : group.second) {
+                    indices.push_back(base + index);
+                }
+            }
+
+            auto vb_name = fmt::format("Area Chunk {},{} Vertex Buffer", cx, cy);
+            auto ib_name = fmt::format("Area Chunk {},{} Index Buffer", cx, cy);
+
+            Diligent::BufferDesc vertexBufferDesc;
+            vertexBufferDesc.Name = vb_name.c_str();
+            vertexBufferDesc.Usage = Diligent::USAGE_IMMUTABLE;
+            vertexBufferDesc.BindFlags = Diligent::BIND_VERTEX_BUFFER;
+            vertexBufferDesc.Size = vertices.size() * sizeof(nw::model::Vertex);
+
+            Diligent::BufferData vertexBufferData;
+            vertexBufferData.pData = vertices.data();
+            vertexBufferData.DataSize = vertexBufferDesc.Size;
+            renderer().device()->CreateBuffer(vertexBufferDesc, &vertexBufferData, &chunk.vertices);
+
+            Diligent::BufferDesc indexBufferDesc;
+            indexBufferDesc.Name = ib_name.c_str();
+            indexBufferDesc.Usage = Diligent::USAGE_IMMUTABLE;
+            indexBufferDesc.BindFlags = Diligent::BIND_INDEX_BUFFER;
+            indexBufferDesc.Size = indices.size() * sizeof(uint32_t);
+
+            Diligent::BufferData indexBufferData;
+            indexBufferData.pData = indices.data();
+            indexBufferData.DataSize = indexBufferDesc.Size;
+            renderer().device()->CreateBuffer(indexBufferDesc, &indexBufferData, &chunk.indices);
+        }
+    }
+    chunks_->baked = true;
+
+    if (baked_meshes > 0 && !constant_buffer_) {
+        Diligent::BufferDesc constantBufferDesc;
+        constantBufferDesc.Name = "Area Chunk Constant Buffer";
+        constantBufferDesc.Usage = Diligent::USAGE_DYNAMIC;
+        constantBufferDesc.BindFlags = Diligent::BIND_UNIFORM_BUFFER;
+        constantBufferDesc.CPUAccessFlags = Diligent::CPU_ACCESS_WRITE;
+        constantBufferDesc.Size = sizeof(MeshConstants);
+
+        renderer().device()->CreateBuffer(constantBufferDesc, nullptr, &constant_buffer_);
+    }
+
+    LOG_F(INFO, "[renderer] {} {} static meshes into {} chunks", cached ? "reused" : "baked", baked_meshes,
+        chunks_->chunks.size());
+}
+
+bool BasicTileArea::animating() const noexcept
+{
+    return std::any_of(std::begin(tile_models_), std::end(tile_models_), [](const auto& tile) {
+        return tile && tile->animating();
+    });
 }
 
 void BasicTileArea::update(int32_t dt)
 {
     for (const auto& tile : tile_models_) {
-        tile->update(dt);
+        if (tile) { tile->update(dt); }
     }
 }
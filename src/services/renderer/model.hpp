@@ -1,5 +1,6 @@
 #pragma once
 
+#include "GeometryCache.hpp"
 #include "TextureCache.hpp"
 #include "renderpipelinestate.h"
 
@@ -25,10 +26,15 @@ struct Node {
     virtual ~Node() = default;
 
     virtual void draw(RenderContext& ctx, const glm::mat4& mtx);
+    /// Submits this node, but not its children, ``mtx`` is the model's transform
+    virtual void submit(RenderContext&, const glm::mat4&) { }
+    /// Gets the transform relative to the parent node
+    virtual glm::mat4 local_transform() const;
     glm::mat4 get_transform() const;
     virtual void reset() { }
 
     Model* owner_ = nullptr;
+    int32_t index_ = -1; ///< Index in ``Model::nodes_``
     nw::model::Node* orig_ = nullptr;
     Node* parent_ = nullptr;
     glm::mat4 inverse_{1.0f};
@@ -54,7 +60,8 @@ struct Mesh final : public Node {
     ~Mesh();
 
     virtual void reset() override { }
-    virtual void draw(RenderContext& ctx, const glm::mat4& mtx) override;
+    virtual void submit(RenderContext& ctx, const glm::mat4& mtx) override;
+    virtual glm::mat4 local_transform() const override;
 
     Diligent::RefCntAutoPtr<Diligent::IBuffer> vertices;
     Diligent::RefCntAutoPtr<Diligent::IBuffer> indices;
@@ -64,6 +71,7 @@ struct Mesh final : public Node {
     nw::PltColors plt_colors_{};
     TextureID texture0;
     bool texture0_is_plt = false;
+    bool baked_ = false; ///< Drawn as part of a ``BasicTileArea`` chunk instead of by itself
 };
 
 struct SkinConstants {
@@ -82,7 +90,9 @@ struct Skin final : public Node {
     ~Skin();
     virtual void reset() override { }
     // Submits mesh data to the GPU
-    virtual void draw(RenderContext& ctx, const glm::mat4& mtx) override;
+    virtual void submit(RenderContext& ctx, const glm::mat4& mtx) override;
+    // Skins don't transform their children, vertices are placed by joints.
+    virtual glm::mat4 local_transform() const override { return glm::mat4{1.0f}; }
 
     Diligent::RefCntAutoPtr<Diligent::IBuffer> vertices;
     Diligent::RefCntAutoPtr<Diligent::IBuffer> indices;
@@ -106,6 +116,10 @@ struct Model : public Node {
     nw::model::Animation* anim_ = nullptr;
     int32_t anim_cursor_ = 0;
     std::vector<std::unique_ptr<Node>> nodes_;
+    std::vector<Node*> anim_targets_;  ///< Node driven by each of ``anim_->nodes``
+    std::vector<glm::mat4> pose_;      ///< Model space transform of each node in ``nodes_``
+    bool pose_dirty_ = true;
+    std::shared_ptr<ModelGeometry> geometry_;
 
     /// Finds a node by name
     Node* find(std::string_view name);
@@ -116,15 +130,25 @@ struct Model : public Node {
     /// Loads model from a NWN model
     bool load(nw::model::Model* mdl);
 
+    /// Determines if an animation is playing
+    bool animating() const noexcept { return !!anim_; }
+
     /// Loads an animation
     bool load_animation(std::string_view anim);
 
     /// Updates the animimation by ``dt`` milliseconds.
     void update(int32_t dt);
 
+    /// Computes ``pose_`` in a single pass, ``nodes_`` is ordered parent before child
+    void update_pose();
+
     virtual void draw(RenderContext& ctx, const glm::mat4& mtx) override;
 
 private:
+    // Gets shared vertex and index buffers for the mesh node that will be ``nodes_[index]``, creating them if necessary
+    MeshGeometry mesh_geometry(int32_t index, const void* vertices, size_t vertices_size,
+        const uint16_t* indices, size_t indices_count, std::string_view kind);
+
     // Internal node loading
     Node* load_node(nw::model::Node* node, Node* parent = nullptr);
 };
@@ -134,16 +158,34 @@ std::unique_ptr<Model> load_model(std::string_view resref);
 // == BasicTileArea ===========================================================
 // ============================================================================
 
+/// Renders an area's tiles
+///
+/// Static tile meshes are baked into chunks of ``chunk_size`` x ``chunk_size`` tiles when loaded, each
+/// drawn with one call per texture. Meshes that an animation could move are still drawn per tile.
 class BasicTileArea : public Node {
 public:
     BasicTileArea(nw::Area* area);
 
+    /// Number of tiles along each side of a baked chunk
+    static constexpr size_t chunk_size = 4;
+
     virtual void draw(RenderContext& ctx, const glm::mat4& mtx) override;
     void load_tile_models();
 
+    /// Determines if any tile is animating
+    bool animating() const noexcept;
+
     /// Updates the animimation by ``dt`` milliseconds.
     void update(int32_t dt);
 
     nw::Area* area_ = nullptr;
-    std::vector<std::unique_ptr<Model>> tile_models_;
+    std::vector<std::unique_ptr<Model>> tile_models_; ///< Row major, null if a tile model failed to load
+    std::shared_ptr<AreaGeometry> chunks_;
+    std::vector<uint32_t> chunk_textures_; ///< ``TextureID::id`` per ``AreaGeometry::textures``, held by the tile models
+    Diligent::RefCntAutoPtr<Diligent::IBuffer> constant_buffer_;
+
+private:
+    // Bakes static tile meshes into ``chunks_``, or reuses a cached bake of the same area layout
+    void bake_static_geometry();
+    void draw_chunks(RenderContext& ctx, const glm::mat4& mtx);
 };
@@ -6,3 +6,12 @@ size_t RenderPipelineState::hash() const
 {
     return XXH3_64bits(this, sizeof(*this));
 }
+
+std::span<const RenderPipelineState> known_pipeline_states()
+{
+    static const RenderPipelineState s_states[] = {
+        {.has_diffuse = true},
+        {.has_diffuse = true, .has_skin = true},
+    };
+    return s_states;
+}
@@ -2,6 +2,7 @@
 
 #include <compare>
 #include <cstddef>
+#include <span>
 
 struct RenderPipelineState {
     bool has_diffuse = false;
@@ -13,3 +14,6 @@ struct RenderPipelineState {
 
     size_t hash() const;
 };
+
+/// Permutations used by ``Mesh`` and ``Skin``, precompiled at startup
+std::span<const RenderPipelineState> known_pipeline_states();
@@ -4,6 +4,8 @@
 #include <nw/kernel/Strings.hpp>
 #include <nw/model/Mdl.hpp>
 
+#include <QStandardPaths>
+
 #if defined(_WIN32)
 #include <DiligentCore/Graphics/GraphicsEngineD3D12/interface/EngineFactoryD3D12.h>
 #elif defined(__APPLE__)
@@ -14,6 +16,19 @@
 
 const std::type_index RenderService::type_index = std::type_index(typeid(RenderService));
 
+namespace {
+
+constexpr std::string_view pipeline_cache_entry = "pipelines.cache";
+
+std::filesystem::path disk_cache_root()
+{
+    auto root = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation);
+    if (root.isEmpty()) { return {}; }
+    return std::filesystem::path{(root + "/arclight/renderer").toStdU16String()};
+}
+
+} // namespace
+
 RenderService::RenderService(nw::MemoryResource* memory)
     : nw::kernel::Service(memory)
     , device_type_(Diligent::RENDER_DEVICE_TYPE_UNDEFINED)
@@ -41,6 +56,8 @@ RenderService::RenderService(nw::MemoryResource* memory)
 #if defined(_WIN32)
     Diligent::EngineD3D12CreateInfo createInfo;
     createInfo.Features.SeparablePrograms = Diligent::DEVICE_FEATURE_STATE_ENABLED;
+    createInfo.Features.TimestampQueries = Diligent::DEVICE_FEATURE_STATE_OPTIONAL;
+    createInfo.Features.AsyncShaderCompilation = Diligent::DEVICE_FEATURE_STATE_OPTIONAL;
     createInfo.EnableValidation = true;
     d3d12Factory->CreateDeviceAndContextsD3D12(
         createInfo,
@@ -48,12 +65,16 @@ RenderService::RenderService(nw::MemoryResource* memory)
         &immediate_ctx_);
 #elif defined(__APPLE__)
     Diligent::EngineMtlCreateInfo createInfo;
+    createInfo.Features.TimestampQueries = Diligent::DEVICE_FEATURE_STATE_OPTIONAL;
+    createInfo.Features.AsyncShaderCompilation = Diligent::DEVICE_FEATURE_STATE_OPTIONAL;
     metalEngineFactory->CreateDeviceAndContextsMtl(
         createInfo,
         &device_,
         &immediate_ctx_);
 #else
     Diligent::EngineVkCreateInfo createInfo;
+    createInfo.Features.TimestampQueries = Diligent::DEVICE_FEATURE_STATE_OPTIONAL;
+    createInfo.Features.AsyncShaderCompilation = Diligent::DEVICE_FEATURE_STATE_OPTIONAL;
     vkEngineFactory->CreateDeviceAndContextsVk(
         createInfo,
         &device_,
@@ -64,7 +85,14 @@ RenderService::RenderService(nw::MemoryResource* memory)
         throw std::runtime_error("Failed to create render device");
     }
 
-    shaders_ = ShaderManager(device_);
+    Diligent::FenceDesc fence_desc;
+    fence_desc.Name = "Frame Fence";
+    fence_desc.Type = Diligent::FENCE_TYPE_CPU_WAIT_ONLY;
+    device_->CreateFence(fence_desc, &frame_fence_);
+
+    disk_cache_ = DiskCache{disk_cache_root(), device_};
+    shaders_ = ShaderManager(device_, &disk_cache_);
+    load_pipeline_cache();
 
     shaders_.load("basic_vs",
         Diligent::SHADER_TYPE_VERTEX,
@@ -182,7 +210,16 @@ RenderService::RenderService(nw::MemoryResource* memory)
 
 RenderService::~RenderService()
 {
+    save_pipeline_cache();
     contexts_.clear();
+    geometry_.clear();
+    pso_map_.clear();
+    pso_cache_.Release();
+    texture_srb_.Release();
+    texture_signature_.Release();
+    mesh_signature_.Release();
+    skin_signature_.Release();
+    frame_fence_.Release();
 
     immediate_ctx_.Release();
     device_.Release();
@@ -198,18 +235,174 @@ void RenderService::initialize(nw::kernel::ServiceInitTime time)
     textures_.load_placeholder();
     textures_.load_palette_texture();
     textures_.load_samplers();
+
+    create_resource_signatures();
+    precompile_pipelines();
+}
+
+void RenderService::unload_module()
+{
+    geometry_.clear();
+}
+
+void RenderService::load_pipeline_cache()
+{
+    // Only D3D12 and Vulkan implement pipeline caches.
+    if (device_type_ != Diligent::RENDER_DEVICE_TYPE_D3D12 && device_type_ != Diligent::RENDER_DEVICE_TYPE_VULKAN) {
+        return;
+    }
+
+    auto data = disk_cache_.read(pipeline_cache_entry);
+
+    Diligent::PipelineStateCacheCreateInfo ci;
+    ci.Desc.Name = "Arclight Pipeline Cache";
+    ci.pCacheData = data.empty() ? nullptr : data.data();
+    ci.CacheDataSize = static_cast<Diligent::Uint32>(data.size());
+    device_->CreatePipelineStateCache(ci, &pso_cache_);
+
+    if (!pso_cache_ && !data.empty()) {
+        // Most likely written by a different driver version, start over.
+        LOG_F(WARNING, "[renderer] discarding incompatible pipeline cache");
+        ci.pCacheData = nullptr;
+        ci.CacheDataSize = 0;
+        device_->CreatePipelineStateCache(ci, &pso_cache_);
+    } else if (pso_cache_ && !data.empty()) {
+        LOG_F(INFO, "[renderer] loaded pipeline cache, {} bytes", data.size());
+    }
+}
+
+void RenderService::save_pipeline_cache()
+{
+    if (!pso_cache_) { return; }
+
+    Diligent::RefCntAutoPtr<Diligent::IDataBlob> blob;
+    pso_cache_->GetData(&blob);
+    if (blob && blob->GetSize() > 0) {
+        disk_cache_.write(pipeline_cache_entry, blob->GetConstDataPtr(), blob->GetSize());
+    }
+}
+
+void RenderService::precompile_pipelines()
+{
+    const bool async = device_->GetDeviceInfo().Features.AsyncShaderCompilation;
+    for (const auto& rps : known_pipeline_states()) {
+        auto hash = rps.hash();
+        if (pso_map_.contains(hash)) { continue; }
+        if (auto pso = create_pso(rps, async)) {
+            pso_map_.insert({hash, {pso, {}}});
+        }
+    }
 }
 
 std::pair<RenderService::pso_type, RenderService::srb_type> RenderService::get_pso(const RenderPipelineState& rps)
 {
     auto hash = rps.hash();
     auto it = pso_map_.find(hash);
-    if (it != std::end(pso_map_)) {
+    if (it != std::end(pso_map_) && it->second.second) {
         return it->second;
     }
 
-    RenderService::pso_type pso;
+    RenderService::pso_type pso = it != std::end(pso_map_) ? it->second.first : create_pso(rps, false);
     RenderService::srb_type srb;
+    if (!pso) { return {}; }
+
+    if (pso->GetStatus(true) != Diligent::PIPELINE_STATE_STATUS_READY) {
+        LOG_F(ERROR, "Failed to compile PSO");
+        pso_map_.erase(hash);
+        return {};
+    }
+
+    auto& signature = rps.has_skin ? skin_signature_ : mesh_signature_;
+    signature->CreateShaderResourceBinding(&srb, true);
+    if (!srb) {
+        LOG_F(ERROR, "Failed to create SRB");
+        return {};
+    }
+
+    pso_map_[hash] = {pso, srb};
+    return {pso, srb};
+}
+
+void RenderService::bind_pipeline(Diligent::IPipelineState* pso, Diligent::IShaderResourceBinding* srb)
+{
+    if (pso != bound_pso_) {
+        immediate_ctx_->SetPipelineState(pso);
+        stats_.bind_pso(pso);
+        bound_pso_ = pso;
+
+        // All pipelines share the texture table's signature, so it stays bound across switches. Newly
+        // written textures only need transitioning once, the first commit of a frame.
+        immediate_ctx_->CommitShaderResources(texture_srb_,
+            texture_table_committed_
+                ? Diligent::RESOURCE_STATE_TRANSITION_MODE_VERIFY
+                : Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        texture_table_committed_ = true;
+    }
+    immediate_ctx_->CommitShaderResources(srb, Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+}
+
+void RenderService::create_resource_signatures()
+{
+    auto resource = [](Diligent::SHADER_TYPE stages, const char* name, Diligent::Uint32 size,
+                        Diligent::SHADER_RESOURCE_TYPE type, Diligent::SHADER_RESOURCE_VARIABLE_TYPE var_type) {
+        Diligent::PipelineResourceDesc result;
+        result.ShaderStages = stages;
+        result.Name = name;
+        result.ArraySize = size;
+        result.ResourceType = type;
+        result.VarType = var_type;
+        return result;
+    };
+
+    // Texture table, one descriptor set for every pipeline
+    Diligent::PipelineResourceDesc texture_resources[] = {
+        resource(Diligent::SHADER_TYPE_PIXEL, "g_Textures", static_cast<Diligent::Uint32>(textures().texture_views.size()),
+            Diligent::SHADER_RESOURCE_TYPE_TEXTURE_SRV, Diligent::SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE),
+    };
+
+    Diligent::ImmutableSamplerDesc samplers[] = {
+        {Diligent::SHADER_TYPE_PIXEL, "g_Texture_sampler", textures().default_sampler->GetDesc()},
+    };
+
+    Diligent::PipelineResourceSignatureDesc desc;
+    desc.Name = "Texture Table";
+    desc.Resources = texture_resources;
+    desc.NumResources = 1;
+    desc.ImmutableSamplers = samplers;
+    desc.NumImmutableSamplers = 1;
+    desc.BindingIndex = 0;
+    device_->CreatePipelineResourceSignature(desc, &texture_signature_);
+    CHECK_F(!!texture_signature_, "failed to create texture table signature");
+
+    texture_signature_->CreateShaderResourceBinding(&texture_srb_, true);
+    CHECK_F(!!texture_srb_, "failed to create texture table SRB");
+    texture_table_ = texture_srb_->GetVariableByName(Diligent::SHADER_TYPE_PIXEL, "g_Textures");
+
+    // Per draw constants
+    Diligent::PipelineResourceDesc skin_resources[] = {
+        resource(Diligent::SHADER_TYPE_VERTEX, "Constants", 1,
+            Diligent::SHADER_RESOURCE_TYPE_CONSTANT_BUFFER, Diligent::SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC),
+        resource(Diligent::SHADER_TYPE_VERTEX, "Joints", 1,
+            Diligent::SHADER_RESOURCE_TYPE_CONSTANT_BUFFER, Diligent::SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC),
+    };
+
+    desc = {};
+    desc.Name = "Mesh Constants";
+    desc.Resources = skin_resources;
+    desc.NumResources = 1;
+    desc.BindingIndex = 1;
+    device_->CreatePipelineResourceSignature(desc, &mesh_signature_);
+    CHECK_F(!!mesh_signature_, "failed to create mesh signature");
+
+    desc.Name = "Skin Constants";
+    desc.NumResources = 2;
+    device_->CreatePipelineResourceSignature(desc, &skin_signature_);
+    CHECK_F(!!skin_signature_, "failed to create skin signature");
+}
+
+RenderService::pso_type RenderService::create_pso(const RenderPipelineState& rps, bool async)
+{
+    RenderService::pso_type pso;
 
     Diligent::GraphicsPipelineStateCreateInfo pso_ci;
     auto& pso_desc = pso_ci.PSODesc;
@@ -258,75 +451,57 @@ std::pair<RenderService::pso_type, RenderService::srb_type> RenderService::get_p
     pso_ci.GraphicsPipeline.RasterizerDesc.CullMode = Diligent::CULL_MODE_BACK;
     pso_ci.GraphicsPipeline.RasterizerDesc.FrontCounterClockwise = true;
 
-    std::vector<Diligent::ShaderResourceVariableDesc> vars;
-    if (rps.has_skin) {
-        vars = {
-            {Diligent::SHADER_TYPE_VERTEX, "Constants", Diligent::SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
-            {Diligent::SHADER_TYPE_VERTEX, "Joints", Diligent::SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
-            {Diligent::SHADER_TYPE_PIXEL, "g_Textures", Diligent::SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE},
-            {Diligent::SHADER_TYPE_PIXEL, "g_Texture_sampler", Diligent::SHADER_RESOURCE_VARIABLE_TYPE_STATIC},
-        };
-    } else {
-        vars = {
-            {Diligent::SHADER_TYPE_VERTEX, "Constants", Diligent::SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
-            {Diligent::SHADER_TYPE_PIXEL, "g_Textures", Diligent::SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE},
-            {Diligent::SHADER_TYPE_PIXEL, "g_Texture_sampler", Diligent::SHADER_RESOURCE_VARIABLE_TYPE_STATIC},
-        };
+    Diligent::IPipelineResourceSignature* signatures[] = {
+        texture_signature_,
+        rps.has_skin ? skin_signature_ : mesh_signature_,
+    };
+    pso_ci.ppResourceSignatures = signatures;
+    pso_ci.ResourceSignaturesCount = 2;
+
+    pso_ci.pPSOCache = pso_cache_;
+    if (async) {
+        pso_ci.Flags |= Diligent::PSO_CREATE_FLAG_ASYNCHRONOUS;
     }
-    pso_ci.PSODesc.ResourceLayout.Variables = vars.data();
-    pso_ci.PSODesc.ResourceLayout.NumVariables = static_cast<Diligent::Uint32>(vars.size());
 
-    renderer().device()->CreateGraphicsPipelineState(pso_ci, &pso);
+    device_->CreateGraphicsPipelineState(pso_ci, &pso);
     if (!pso) {
         LOG_F(ERROR, "Failed to create PSO");
-        return {};
     }
+    return pso;
+}
 
-    pso->GetStaticVariableByName(Diligent::SHADER_TYPE_PIXEL, "g_Texture_sampler")->Set(textures().default_sampler);
-
-    pso->CreateShaderResourceBinding(&srb, true);
-    if (!srb) {
-        LOG_F(ERROR, "Failed to create SRB");
-        return {};
-    }
+void RenderService::pre_frame()
+{
+    bound_pso_ = nullptr;
+    texture_table_committed_ = false;
 
-    std::vector<Diligent::IDeviceObject*> textureViewPtrs(textures().texture_views.size());
-    for (size_t i = 0; i < textures().texture_views.size(); ++i) {
-        textureViewPtrs[i] = textures().texture_views[i].RawPtr();
-    }
+    if (!textures().dirty()) { return; }
 
-    srb->GetVariableByName(Diligent::SHADER_TYPE_PIXEL, "g_Textures")
-        ->SetArray(textureViewPtrs.data(),
-            0,
-            static_cast<Diligent::Uint32>(textureViewPtrs.size()),
-            Diligent::SET_SHADER_RESOURCE_FLAG_ALLOW_OVERWRITE);
+    // The texture table is a single descriptor set, it can't be rewritten while a submitted frame may
+    // still read it. Render targets currently wait on every frame for its readback, so this doesn't stall.
+    wait_frame(frame_value_);
 
-    if (pso && srb) {
-        pso_map_.insert({hash, {pso, srb}});
+    if (!texture_table_) { return; }
+    for (auto [first, count] : textures().take_dirty_ranges()) {
+        std::vector<Diligent::IDeviceObject*> views(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            views[i] = textures().texture_views[first + i].RawPtr();
+        }
+        texture_table_->SetArray(views.data(), first, count, Diligent::SET_SHADER_RESOURCE_FLAG_ALLOW_OVERWRITE);
     }
-
-    return {pso, srb};
 }
 
-void RenderService::pre_frame()
+uint64_t RenderService::submit_frame()
 {
-    renderer().immediate_context()->WaitForIdle();
-
-    if (textures().dirty()) {
-        std::vector<Diligent::IDeviceObject*> textureViewPtrs(textures().texture_views.size());
-        for (size_t i = 0; i < textures().texture_views.size(); ++i) {
-            textureViewPtrs[i] = textures().texture_views[i].RawPtr();
-        }
+    immediate_ctx_->EnqueueSignal(frame_fence_, ++frame_value_);
+    immediate_ctx_->Flush();
+    return frame_value_;
+}
 
-        for (auto& [_, v] : pso_map_) {
-            v.second->GetVariableByName(Diligent::SHADER_TYPE_PIXEL, "g_Textures")
-                ->SetArray(textureViewPtrs.data(),
-                    0,
-                    static_cast<Diligent::Uint32>(textureViewPtrs.size()),
-                    Diligent::SET_SHADER_RESOURCE_FLAG_ALLOW_OVERWRITE);
-        }
-        textures().set_dirty(false);
-    }
+void RenderService::wait_frame(uint64_t value)
+{
+    if (value == 0 || frame_fence_->GetCompletedValue() >= value) { return; }
+    frame_fence_->Wait(value);
 }
 
 std::string RenderService::device_type_as_string() const
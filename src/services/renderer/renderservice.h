@@ -1,11 +1,17 @@
 #pragma once
 
+#include "DiskCache.hpp"
+#include "GeometryCache.hpp"
 #include "TextureCache.hpp"
 #include "renderpipelinestate.h"
+#include "renderstats.h"
 #include "shadermanager.h"
 
 #include <DiligentCore/Common/interface/RefCntAutoPtr.hpp>
 #include <DiligentCore/Graphics/GraphicsEngine/interface/DeviceContext.h>
+#include <DiligentCore/Graphics/GraphicsEngine/interface/Fence.h>
+#include <DiligentCore/Graphics/GraphicsEngine/interface/PipelineResourceSignature.h>
+#include <DiligentCore/Graphics/GraphicsEngine/interface/PipelineStateCache.h>
 #include <DiligentCore/Graphics/GraphicsEngine/interface/RenderDevice.h>
 #include <DiligentCore/Graphics/GraphicsEngine/interface/SwapChain.h>
 #include <glm/mat4x4.hpp>
@@ -50,12 +56,28 @@ public:
     /// Get a string representation of the API being used
     std::string device_type_as_string() const;
 
-    /// Gets PSO and SRB
+    /// Gets PSO and its per draw SRB, the first call for a state waits for it to finish compiling if it
+    /// was precompiled. Textures are bound separately through the shared texture table.
     std::pair<pso_type, srb_type> get_pso(const RenderPipelineState& rps);
 
-    /// Does pre-frame activities
+    /// Binds ``pso``, the shared texture table and ``srb`` for drawing
+    void bind_pipeline(Diligent::IPipelineState* pso, Diligent::IShaderResourceBinding* srb);
+
+    /// Starts compiling ``known_pipeline_states``, asynchronously if the device supports it
+    void precompile_pipelines();
+
+    /// Writes the pipeline cache to disk
+    void save_pipeline_cache();
+
+    /// Does pre-frame activities, i.e. rewriting changed texture table descriptors
     void pre_frame();
 
+    /// Signals the frame fence after all work recorded so far and flushes, returns the fence value
+    uint64_t submit_frame();
+
+    /// Blocks until the GPU has finished the frame ``submit_frame`` returned ``value`` for
+    void wait_frame(uint64_t value);
+
     /// Get shader manager
     ShaderManager& shaders() { return shaders_; }
     const ShaderManager& shaders() const { return shaders_; }
@@ -66,15 +88,45 @@ public:
     /// Get Texture Cache
     const TextureCache& textures() const noexcept { return textures_; }
 
+    /// Get model geometry cache
+    GeometryCache& geometry() { return geometry_; }
+
+    /// Drops cached geometry no model holds, the next module can resolve the same resrefs to other resources
+    void unload_module();
+
+    /// Get per-frame render statistics
+    RenderStats& stats() noexcept { return stats_; }
+    const RenderStats& stats() const noexcept { return stats_; }
+
 private:
+    pso_type create_pso(const RenderPipelineState& rps, bool async);
+    void create_resource_signatures();
+    void load_pipeline_cache();
+
     Diligent::RENDER_DEVICE_TYPE device_type_;
     Diligent::RefCntAutoPtr<Diligent::IRenderDevice> device_;
     Diligent::RefCntAutoPtr<Diligent::IDeviceContext> immediate_ctx_;
     Diligent::RefCntAutoPtr<Diligent::IEngineFactory> engine_factory_;
     std::unordered_map<void*, RenderContext> contexts_;
+    DiskCache disk_cache_;
+    Diligent::RefCntAutoPtr<Diligent::IPipelineStateCache> pso_cache_;
     ShaderManager shaders_;
     TextureCache textures_;
-    absl::flat_hash_map<uint64_t, std::pair<pso_type, srb_type>> pso_map_;
+    GeometryCache geometry_;
+    RenderStats stats_;
+    absl::flat_hash_map<uint64_t, std::pair<pso_type, srb_type>> pso_map_; ///< SRB is null until first use
+
+    // Binding 0 is the texture table shared by all pipelines, binding 1 per draw constants.
+    Diligent::RefCntAutoPtr<Diligent::IPipelineResourceSignature> texture_signature_;
+    Diligent::RefCntAutoPtr<Diligent::IPipelineResourceSignature> mesh_signature_;
+    Diligent::RefCntAutoPtr<Diligent::IPipelineResourceSignature> skin_signature_;
+    srb_type texture_srb_;
+    Diligent::IShaderResourceVariable* texture_table_ = nullptr;
+    Diligent::IPipelineState* bound_pso_ = nullptr;
+    bool texture_table_committed_ = false;
+
+    Diligent::RefCntAutoPtr<Diligent::IFence> frame_fence_;
+    uint64_t frame_value_ = 0;
 };
 
 RenderService& renderer();
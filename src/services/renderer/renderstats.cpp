@@ -0,0 +1,148 @@
+#include "renderstats.h"
+
+const char* render_stage_name(RenderStage stage)
+{
+    switch (stage) {
+    case RenderStage::update:
+        return "update";
+    case RenderStage::pre_frame:
+        return "pre_frame";
+    case RenderStage::render:
+        return "render";
+    case RenderStage::copy_map:
+        return "copy_map";
+    case RenderStage::memcpy:
+        return "memcpy";
+    case RenderStage::wait_gpu:
+        return "wait_gpu";
+    }
+    return "unknown";
+}
+
+double FrameStats::cpu_total_ms() const noexcept
+{
+    double result = 0.0;
+    for (auto ms : cpu_ms) {
+        result += ms;
+    }
+    return result;
+}
+
+// == RenderStats =============================================================
+// ============================================================================
+
+RenderStats::RenderStats(size_t capacity)
+    : capacity_{capacity}
+{
+}
+
+void RenderStats::begin_frame()
+{
+    // Work recorded between frames, e.g. texture uploads while loading, is charged to the next frame.
+    // Only PSO tracking restarts, the first bind of a frame always counts as a switch.
+    last_pso_ = nullptr;
+}
+
+void RenderStats::end_frame()
+{
+    history_.push_back(current_);
+    while (history_.size() > capacity_) {
+        history_.pop_front();
+    }
+    current_ = FrameStats{};
+    current_.frame = ++frame_counter_;
+}
+
+const FrameStats& RenderStats::last() const noexcept
+{
+    static const FrameStats s_empty;
+    return history_.empty() ? s_empty : history_.back();
+}
+
+FrameStats RenderStats::average() const
+{
+    FrameStats result;
+    if (history_.empty()) { return result; }
+
+    size_t gpu_frames = 0;
+    double gpu_total = 0.0;
+    for (const auto& frame : history_) {
+        for (size_t i = 0; i < render_stage_count; ++i) {
+            result.cpu_ms[i] += frame.cpu_ms[i];
+        }
+        if (frame.gpu_ms >= 0.0) {
+            gpu_total += frame.gpu_ms;
+            ++gpu_frames;
+        }
+        result.draws += frame.draws;
+        result.triangles += frame.triangles;
+        result.pso_switches += frame.pso_switches;
+        result.texture_uploads += frame.texture_uploads;
+        result.texture_upload_bytes += frame.texture_upload_bytes;
+        result.readback_bytes += frame.readback_bytes;
+    }
+
+    const auto n = history_.size();
+    for (auto& ms : result.cpu_ms) {
+        ms /= double(n);
+    }
+    result.frame = history_.back().frame;
+    result.gpu_ms = gpu_frames ? gpu_total / double(gpu_frames) : -1.0;
+    result.draws = uint32_t(result.draws / n);
+    result.triangles /= n;
+    result.pso_switches = uint32_t(result.pso_switches / n);
+    result.texture_uploads = uint32_t(result.texture_uploads / n);
+    result.texture_upload_bytes /= n;
+    result.readback_bytes /= n;
+    return result;
+}
+
+void RenderStats::clear()
+{
+    history_.clear();
+}
+
+void RenderStats::draw(uint32_t indices) noexcept
+{
+    ++current_.draws;
+    current_.triangles += indices / 3;
+}
+
+void RenderStats::bind_pso(Diligent::IPipelineState* pso) noexcept
+{
+    if (pso != last_pso_) {
+        ++current_.pso_switches;
+        last_pso_ = pso;
+    }
+}
+
+void RenderStats::texture_upload(uint64_t bytes) noexcept
+{
+    ++current_.texture_uploads;
+    current_.texture_upload_bytes += bytes;
+}
+
+void RenderStats::write_csv(std::ostream& out) const
+{
+    out << "frame";
+    for (size_t i = 0; i < render_stage_count; ++i) {
+        out << ",cpu_" << render_stage_name(RenderStage(i)) << "_ms";
+    }
+    out << ",cpu_total_ms,gpu_ms,draws,triangles,pso_switches,texture_uploads,texture_upload_bytes,readback_bytes\n";
+
+    for (const auto& frame : history_) {
+        out << frame.frame;
+        for (auto ms : frame.cpu_ms) {
+            out << ',' << ms;
+        }
+        out << ',' << frame.cpu_total_ms() << ',';
+        if (frame.gpu_ms >= 0.0) { out << frame.gpu_ms; }
+        out << ',' << frame.draws
+            << ',' << frame.triangles
+            << ',' << frame.pso_switches
+            << ',' << frame.texture_uploads
+            << ',' << frame.texture_upload_bytes
+            << ',' << frame.readback_bytes
+            << '\n';
+    }
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <ostream>
+
+namespace Diligent {
+struct IPipelineState;
+}
+
+/// Timed stages of ``RenderTarget::render``
+enum struct RenderStage : uint8_t {
+    update,    ///< Animation update
+    pre_frame, ///< ``RenderService::pre_frame`` including texture array rebinding
+    render,    ///< Draw submission into the offscreen target
+    copy_map,  ///< FBO to staging copy and map
+    memcpy,    ///< Staging to CPU image copy
+    wait_gpu,  ///< Flush and wait on the frame fence
+};
+
+constexpr size_t render_stage_count = 6;
+
+/// Name of a render stage as used in CSV headers
+const char* render_stage_name(RenderStage stage);
+
+/// Statistics for a single frame
+struct FrameStats {
+    uint64_t frame = 0;
+    std::array<double, render_stage_count> cpu_ms{}; ///< CPU time per ``RenderStage``
+    double gpu_ms = -1.0;                            ///< GPU time, negative if timestamp queries are unsupported
+    uint32_t draws = 0;
+    uint64_t triangles = 0;
+    uint32_t pso_switches = 0;
+    uint32_t texture_uploads = 0;
+    uint64_t texture_upload_bytes = 0;
+    uint64_t readback_bytes = 0;
+
+    /// Sum of all CPU stages
+    double cpu_total_ms() const noexcept;
+};
+
+// == RenderStats =============================================================
+// ============================================================================
+
+/// Collects per-frame render statistics
+///
+/// Counters are bumped by the renderer as work is recorded, ``begin_frame`` and ``end_frame`` bracket
+/// a frame and the finished frame is kept in a bounded history of ``capacity`` frames.
+class RenderStats {
+public:
+    explicit RenderStats(size_t capacity = 600);
+
+    void begin_frame();
+    void end_frame();
+
+    /// Frame currently being recorded
+    FrameStats& current() noexcept { return current_; }
+
+    /// Most recently finished frame
+    const FrameStats& last() const noexcept;
+
+    /// Finished frames, oldest first
+    const std::deque<FrameStats>& history() const noexcept { return history_; }
+
+    /// Mean of the finished frames in history
+    FrameStats average() const;
+
+    void clear();
+
+    /// Records a draw call of ``indices`` triangle list indices
+    void draw(uint32_t indices) noexcept;
+
+    /// Records binding ``pso``, only counted as a switch if it differs from the last bound
+    void bind_pso(Diligent::IPipelineState* pso) noexcept;
+
+    /// Records a texture upload of ``bytes``
+    void texture_upload(uint64_t bytes) noexcept;
+
+    /// Writes history as CSV, one row per frame
+    void write_csv(std::ostream& out) const;
+
+private:
+    size_t capacity_;
+    uint64_t frame_counter_ = 0;
+    FrameStats current_;
+    std::deque<FrameStats> history_;
+    const Diligent::IPipelineState* last_pso_ = nullptr;
+};
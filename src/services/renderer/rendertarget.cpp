@@ -0,0 +1,194 @@
+#include "rendertarget.h"
+
+#include "renderservice.h"
+
+#include <nw/log.hpp>
+
+#include <QElapsedTimer>
+
+#include <cstring>
+
+namespace {
+
+double elapsed_ms(QElapsedTimer& timer)
+{
+    auto result = double(timer.nsecsElapsed()) / 1e6;
+    timer.start();
+    return result;
+}
+
+} // namespace
+
+// == RenderTarget ============================================================
+// ============================================================================
+
+RenderTarget::~RenderTarget()
+{
+    release();
+}
+
+bool RenderTarget::initialize(uint32_t width, uint32_t height)
+{
+    release();
+    if (width == 0 || height == 0) { return false; }
+
+    auto* device = renderer().device();
+    if (!device) {
+        LOG_F(ERROR, "[renderer] no render device");
+        return false;
+    }
+
+    Diligent::TextureDesc ColorDesc;
+    ColorDesc.Name = "FBO Color Buffer";
+    ColorDesc.Type = Diligent::RESOURCE_DIM_TEX_2D;
+    ColorDesc.Width = width;
+    ColorDesc.Height = height;
+    ColorDesc.Format = Diligent::TEX_FORMAT_RGBA8_UNORM_SRGB; // Match your pipeline format
+    ColorDesc.BindFlags = Diligent::BIND_RENDER_TARGET | Diligent::BIND_SHADER_RESOURCE;
+    ColorDesc.Usage = Diligent::USAGE_DEFAULT;
+    ColorDesc.CPUAccessFlags = Diligent::CPU_ACCESS_NONE;
+
+    device->CreateTexture(ColorDesc, nullptr, &color_);
+    CHECK_F(!!color_, "color_ is NULL - descriptor view creation failed!");
+    color_rtv_ = color_->GetDefaultView(Diligent::TEXTURE_VIEW_RENDER_TARGET);
+    CHECK_F(!!color_rtv_, "color_rtv_ is NULL - descriptor view creation failed!");
+
+    Diligent::TextureDesc DepthDesc;
+    DepthDesc.Name = "FBO Depth Buffer";
+    DepthDesc.Type = Diligent::RESOURCE_DIM_TEX_2D;
+    DepthDesc.Width = width;
+    DepthDesc.Height = height;
+    DepthDesc.Format = Diligent::TEX_FORMAT_D32_FLOAT;
+    DepthDesc.BindFlags = Diligent::BIND_DEPTH_STENCIL;
+    DepthDesc.Usage = Diligent::USAGE_DEFAULT;
+    DepthDesc.CPUAccessFlags = Diligent::CPU_ACCESS_NONE;
+
+    device->CreateTexture(DepthDesc, nullptr, &depth_);
+    CHECK_F(!!depth_, "depth_ is NULL - descriptor view creation failed!");
+    depth_dsv_ = depth_->GetDefaultView(Diligent::TEXTURE_VIEW_DEPTH_STENCIL);
+    CHECK_F(!!depth_dsv_, "depth_dsv_ is NULL - descriptor view creation failed!");
+
+    Diligent::TextureDesc StagingDesc;
+    StagingDesc.Name = "Staging Texture";
+    StagingDesc.Type = Diligent::RESOURCE_DIM_TEX_2D;
+    StagingDesc.Width = width;
+    StagingDesc.Height = height;
+    StagingDesc.Format = Diligent::TEX_FORMAT_RGBA8_UNORM_SRGB;
+    StagingDesc.Usage = Diligent::USAGE_STAGING;
+    StagingDesc.CPUAccessFlags = Diligent::CPU_ACCESS_READ;
+    StagingDesc.BindFlags = Diligent::BIND_NONE;
+
+    device->CreateTexture(StagingDesc, nullptr, &staging_);
+    CHECK_F(!!staging_, "staging_ is NULL - descriptor view creation failed!");
+
+    if (device->GetDeviceInfo().Features.TimestampQueries) {
+        Diligent::QueryDesc QueryDesc;
+        QueryDesc.Type = Diligent::QUERY_TYPE_TIMESTAMP;
+        QueryDesc.Name = "Frame Begin";
+        device->CreateQuery(QueryDesc, &gpu_begin_);
+        QueryDesc.Name = "Frame End";
+        device->CreateQuery(QueryDesc, &gpu_end_);
+    }
+
+    width_ = width;
+    height_ = height;
+    return true;
+}
+
+void RenderTarget::release()
+{
+    if (!color_ && !staging_) { return; }
+
+    if (renderer().immediate_context()) {
+        renderer().immediate_context()->Flush();
+        renderer().immediate_context()->WaitForIdle();
+    }
+
+    color_rtv_.Release();
+    color_.Release();
+    depth_dsv_.Release();
+    depth_.Release();
+    staging_.Release();
+    gpu_begin_.Release();
+    gpu_end_.Release();
+    width_ = height_ = 0;
+}
+
+bool RenderTarget::render(const std::function<void()>& update, const std::function<void()>& draw, uint8_t* pixels,
+    size_t stride)
+{
+    auto* ic = renderer().immediate_context();
+    if (!valid() || !ic || !pixels || stride < size_t(width_) * 4) { return false; }
+
+    auto& stats = renderer().stats();
+    stats.begin_frame();
+    auto& frame = stats.current();
+
+    QElapsedTimer timer;
+    timer.start();
+    if (update) { update(); }
+    frame.cpu_ms[size_t(RenderStage::update)] = elapsed_ms(timer);
+
+    renderer().pre_frame();
+    frame.cpu_ms[size_t(RenderStage::pre_frame)] = elapsed_ms(timer);
+
+    if (gpu_begin_) { ic->EndQuery(gpu_begin_); }
+
+    Diligent::ITextureView* pRTVs[] = {color_rtv_};
+    ic->SetRenderTargets(1, pRTVs, depth_dsv_, Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    const float ClearColor[] = {0.2f, 0.3f, 0.3f, 1.0f};
+    ic->ClearRenderTarget(color_rtv_, ClearColor, Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    ic->ClearDepthStencil(depth_dsv_, Diligent::CLEAR_DEPTH_FLAG, 1.0f, 0, Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    if (draw) { draw(); }
+
+    ic->SetRenderTargets(0, nullptr, nullptr, Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    frame.cpu_ms[size_t(RenderStage::render)] = elapsed_ms(timer);
+
+    Diligent::CopyTextureAttribs CopyAttribs;
+    CopyAttribs.pSrcTexture = color_;
+    CopyAttribs.pDstTexture = staging_;
+    CopyAttribs.SrcTextureTransitionMode = Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+    CopyAttribs.DstTextureTransitionMode = Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+    ic->CopyTexture(CopyAttribs);
+
+    if (gpu_end_) { ic->EndQuery(gpu_end_); }
+    frame.cpu_ms[size_t(RenderStage::copy_map)] = elapsed_ms(timer);
+
+    // Only this frame's work needs to finish before the readback, not the whole device. The pixels are
+    // returned for this frame, so nothing is left in flight.
+    renderer().wait_frame(renderer().submit_frame());
+    frame.cpu_ms[size_t(RenderStage::wait_gpu)] = elapsed_ms(timer);
+
+    // The frame fence has been waited on, so the copy has landed and mapping doesn't stall.
+    Diligent::MappedTextureSubresource MappedData;
+    ic->MapTextureSubresource(staging_, 0, 0, Diligent::MAP_READ, Diligent::MAP_FLAG_DO_NOT_WAIT, nullptr, MappedData);
+    frame.cpu_ms[size_t(RenderStage::copy_map)] += elapsed_ms(timer);
+
+    if (MappedData.pData) {
+        const size_t row = size_t(width_) * 4;
+        for (uint32_t y = 0; y < height_; ++y) {
+            std::memcpy(pixels + y * stride, static_cast<const uint8_t*>(MappedData.pData) + y * MappedData.Stride, row);
+        }
+        ic->UnmapTextureSubresource(staging_, 0, 0);
+        frame.readback_bytes += uint64_t(row) * height_;
+    } else {
+        LOG_F(ERROR, "[renderer] failed to map staging texture");
+    }
+    frame.cpu_ms[size_t(RenderStage::memcpy)] = elapsed_ms(timer);
+
+    ic->FinishFrame();
+
+    // The frame has completed, so the timestamps are available without stalling.
+    Diligent::QueryDataTimestamp begin, end;
+    if (gpu_begin_ && gpu_end_
+        && gpu_begin_->GetData(&begin, sizeof(begin))
+        && gpu_end_->GetData(&end, sizeof(end))
+        && end.Frequency > 0) {
+        frame.gpu_ms = double(end.Counter - begin.Counter) * 1000.0 / double(end.Frequency);
+    }
+    stats.end_frame();
+
+    return MappedData.pData != nullptr;
+}
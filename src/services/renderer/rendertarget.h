@@ -0,0 +1,55 @@
+#pragma once
+
+#include <DiligentCore/Common/interface/RefCntAutoPtr.hpp>
+#include <DiligentCore/Graphics/GraphicsEngine/interface/Query.h>
+#include <DiligentCore/Graphics/GraphicsEngine/interface/Texture.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+// == RenderTarget ============================================================
+// ============================================================================
+
+/// Offscreen color and depth buffers, plus the staging texture a finished frame is read back through.
+///
+/// Needs no window or swap chain, so ``RenderWidget`` and the headless renderer share it and produce
+/// the same images and statistics.
+class RenderTarget {
+public:
+    RenderTarget() = default;
+    RenderTarget(const RenderTarget&) = delete;
+    RenderTarget& operator=(const RenderTarget&) = delete;
+    ~RenderTarget();
+
+    /// Creates ``width`` x ``height`` targets, replacing any previous ones
+    bool initialize(uint32_t width, uint32_t height);
+
+    /// Waits for the GPU and releases the targets
+    void release();
+
+    bool valid() const noexcept { return !!staging_; }
+    uint32_t width() const noexcept { return width_; }
+    uint32_t height() const noexcept { return height_; }
+
+    /// Renders a frame and reads it back into ``pixels``, RGBA8 rows ``stride`` bytes apart
+    ///
+    /// ``update`` advances animations and ``draw`` submits into the bound targets. Stage timings, GPU time,
+    /// and counters are recorded to ``RenderService::stats``.
+    bool render(const std::function<void()>& update, const std::function<void()>& draw, uint8_t* pixels,
+        size_t stride);
+
+private:
+    Diligent::RefCntAutoPtr<Diligent::ITexture> color_;
+    Diligent::RefCntAutoPtr<Diligent::ITextureView> color_rtv_;
+    Diligent::RefCntAutoPtr<Diligent::ITexture> depth_;
+    Diligent::RefCntAutoPtr<Diligent::ITextureView> depth_dsv_;
+    Diligent::RefCntAutoPtr<Diligent::ITexture> staging_;
+
+    // GPU timestamps bracketing the frame, null if the device doesn't support them
+    Diligent::RefCntAutoPtr<Diligent::IQuery> gpu_begin_;
+    Diligent::RefCntAutoPtr<Diligent::IQuery> gpu_end_;
+
+    uint32_t width_ = 0;
+    uint32_t height_ = 0;
+};
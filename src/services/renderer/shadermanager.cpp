@@ -1,12 +1,22 @@
 #include "shadermanager.h"
 
+#include "DiskCache.hpp"
+
 #include <nw/util/error_context.hpp>
 
 #include <DiligentCore/Graphics/GraphicsTools/interface/ShaderMacroHelper.hpp>
+#include <xxhash/xxh3.h>
 
-ShaderManager::ShaderManager(Diligent::IRenderDevice* device)
+ShaderManager::ShaderManager(Diligent::IRenderDevice* device, const DiskCache* cache)
     : device_{device}
 {
+    // Only backends with a stable, device independent bytecode format are cached.
+    if (device_ && cache && cache->enabled()) {
+        auto type = device_->GetDeviceInfo().Type;
+        if (type == Diligent::RENDER_DEVICE_TYPE_VULKAN || type == Diligent::RENDER_DEVICE_TYPE_D3D12) {
+            cache_ = cache;
+        }
+    }
 }
 
 Diligent::IShader* ShaderManager::get(std::string_view name) const
@@ -31,7 +41,31 @@ Diligent::IShader* ShaderManager::load(const std::string& name, Diligent::SHADER
     }
     shaderCI.Macros = macro_helper;
 
-    device_->CreateShader(shaderCI, &shader);
+    // No source stream factory is set, so ``source`` is all there is to compile and all the key needs
+    // to cover.  Should a shader ever ``#include`` anything, it's compiled every time rather than
+    // risk loading stale bytecode.
+    std::string entry;
+    if (cache_ && source.find("#include") == std::string::npos) {
+        XXH3_state_t* state = XXH3_createState();
+        XXH3_64bits_reset(state);
+        XXH3_64bits_update(state, &type, sizeof(type));
+        XXH3_64bits_update(state, source.data(), source.size());
+        for (const auto& [n, value] : macros) {
+            XXH3_64bits_update(state, n.data(), n.size() + 1);
+            XXH3_64bits_update(state, value.data(), value.size() + 1);
+        }
+        entry = fmt::format("{}-{:016x}.shader", name, XXH3_64bits_digest(state));
+        XXH3_freeState(state);
+
+        shader = load_cached(shaderCI, entry);
+    }
+
+    if (!shader) {
+        device_->CreateShader(shaderCI, &shader);
+        if (shader && !entry.empty()) {
+            store_cached(shader, entry);
+        }
+    }
 
     if (shader) {
         auto [it, inserted] = shaders_.emplace(name, shader);
@@ -46,3 +80,35 @@ Diligent::IShader* ShaderManager::load(const std::string& name, Diligent::SHADER
 
     return nullptr;
 }
+
+Diligent::RefCntAutoPtr<Diligent::IShader> ShaderManager::load_cached(const Diligent::ShaderCreateInfo& shaderCI,
+    const std::string& entry)
+{
+    Diligent::RefCntAutoPtr<Diligent::IShader> shader;
+
+    auto bytecode = cache_->read(entry);
+    if (bytecode.empty()) { return shader; }
+
+    // Source language stays HLSL so that vertex inputs are still mapped by semantic.
+    Diligent::ShaderCreateInfo ci = shaderCI;
+    ci.Source = nullptr;
+    ci.Macros = {};
+    ci.ByteCode = bytecode.data();
+    ci.ByteCodeSize = bytecode.size();
+    device_->CreateShader(ci, &shader);
+
+    if (shader) {
+        LOG_F(INFO, "[renderer] loaded shader '{}' from cache", shaderCI.Desc.Name);
+    } else {
+        LOG_F(WARNING, "[renderer] discarding cached shader '{}', recompiling", shaderCI.Desc.Name);
+    }
+    return shader;
+}
+
+void ShaderManager::store_cached(Diligent::IShader* shader, const std::string& entry)
+{
+    const void* bytecode = nullptr;
+    Diligent::Uint64 size = 0;
+    shader->GetBytecode(&bytecode, size);
+    cache_->write(entry, bytecode, static_cast<size_t>(size));
+}
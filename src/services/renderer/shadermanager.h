@@ -8,18 +8,27 @@
 
 #include <string>
 
+class DiskCache;
+
 class ShaderManager {
 public:
-    explicit ShaderManager(Diligent::IRenderDevice* device = nullptr);
+    /// If ``cache`` is non-null compiled bytecode is stored there and reused while the source is unchanged
+    explicit ShaderManager(Diligent::IRenderDevice* device = nullptr, const DiskCache* cache = nullptr);
 
     /// Get a previously loaded shader
     Diligent::IShader* get(std::string_view name) const;
 
-    /// Load shader from source code strings, handling platform differences
+    /// Load shader from source code strings, handling platform differences.  Sources are self contained,
+    /// ``#include`` isn't resolved.
     Diligent::IShader* load(const std::string& name, Diligent::SHADER_TYPE type, const std::string& source,
         const std::vector<std::pair<std::string, std::string>>& macros = {});
 
 private:
+    Diligent::RefCntAutoPtr<Diligent::IShader> load_cached(const Diligent::ShaderCreateInfo& shaderCI,
+        const std::string& entry);
+    void store_cached(Diligent::IShader* shader, const std::string& entry);
+
     Diligent::IRenderDevice* device_ = nullptr;
+    const DiskCache* cache_ = nullptr;
     absl::flat_hash_map<std::string, Diligent::RefCntAutoPtr<Diligent::IShader>> shaders_;
 };
@@ -0,0 +1,94 @@
+#include "lazyiconmodel.h"
+
+#include "nw/formats/Image.hpp"
+#include "nw/kernel/Resources.hpp"
+#include "nw/log.hpp"
+
+#include <QFutureWatcher>
+#include <QIcon>
+#include <QPixmapCache>
+#include <QtConcurrent/QtConcurrent>
+
+#include <algorithm>
+
+LazyIconModel::LazyIconModel(QString cache_tag, Transform transform, QObject* parent)
+    : QStandardItemModel(parent)
+    , cache_tag_{std::move(cache_tag)}
+    , transform_{std::move(transform)}
+{
+}
+
+QVariant LazyIconModel::data(const QModelIndex& index, int role) const
+{
+    if (role != Qt::DecorationRole || !index.isValid()) {
+        return QStandardItemModel::data(index, role);
+    }
+
+    auto resref = QStandardItemModel::data(index, ResrefRole).toString();
+    if (resref.isEmpty()) {
+        return QStandardItemModel::data(index, role);
+    }
+
+    QPixmap pixmap;
+    if (QPixmapCache::find(cache_tag_ + resref, &pixmap)) {
+        return QIcon(pixmap);
+    }
+
+    if (!failed_.contains(resref)) {
+        load(resref, index);
+    }
+    return {};
+}
+
+void LazyIconModel::load(const QString& resref, const QModelIndex& index) const
+{
+    auto it = pending_.find(resref);
+    if (it != pending_.end()) {
+        it->append(QPersistentModelIndex(index));
+        return;
+    }
+    pending_.insert(resref, {QPersistentModelIndex(index)});
+
+    // Resource lookups stay on the GUI thread, only decoding is moved off of it.
+    auto rdata = nw::kernel::resman().demand_in_order(nw::Resref(resref.toStdString()),
+        {nw::ResourceType::dds, nw::ResourceType::tga});
+
+    auto self = const_cast<LazyIconModel*>(this);
+    auto watcher = new QFutureWatcher<QImage>(self);
+    QObject::connect(watcher, &QFutureWatcher<QImage>::finished, self, [self, watcher, resref]() {
+        auto image = watcher->result();
+        watcher->deleteLater();
+
+        auto indices = self->pending_.take(resref);
+        if (image.isNull()) {
+            self->failed_.insert(resref);
+            return;
+        }
+
+        QPixmapCache::insert(self->cache_tag_ + resref, QPixmap::fromImage(image));
+        for (const auto& idx : indices) {
+            if (idx.isValid()) {
+                emit self->dataChanged(idx, idx, {Qt::DecorationRole});
+            }
+        }
+    });
+
+    watcher->setFuture(QtConcurrent::run([rdata = std::move(rdata), transform = transform_]() mutable -> QImage {
+        if (rdata.bytes.size() == 0) { return {}; }
+
+        nw::Image icon{std::move(rdata)};
+        if (!icon.valid()) { return {}; }
+
+        QImage image(icon.release(), icon.width(), icon.height(), icon.channels() == 4 ? QImage::Format_RGBA8888 : QImage::Format_RGB888,
+            [](void* bytes) { if (bytes) { free(bytes); } });
+
+        // stb automatically flips standard dds and tga,
+        // so here for bioware dds which is implemented a bit differently
+        // needs to be flipped back to right side up.
+        if (icon.is_bio_dds()) {
+            image.mirror();
+        }
+
+        return transform ? transform(std::move(image)) : image;
+    }));
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <QHash>
+#include <QImage>
+#include <QPersistentModelIndex>
+#include <QSet>
+#include <QStandardItemModel>
+
+#include <functional>
+
+/// Standard item model whose item icons are decoded the first time a view asks for them.
+///
+/// Items store the icon's resref in ``LazyIconModel::ResrefRole``. Resource data is read on the
+/// calling thread, decoding happens on the global thread pool, and finished pixmaps are shared
+/// through ``QPixmapCache`` so every model displaying the same icon reuses it.  The cache limit is
+/// the application's to set, see ``main``.
+class LazyIconModel : public QStandardItemModel {
+public:
+    /// Applied to decoded images on the worker thread
+    using Transform = std::function<QImage(QImage)>;
+
+    static constexpr int ResrefRole = Qt::UserRole + 16;
+
+    /// ``cache_tag`` distinguishes transformed images of the same resource in the pixmap cache.
+    explicit LazyIconModel(QString cache_tag = {}, Transform transform = {}, QObject* parent = nullptr);
+
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+private:
+    void load(const QString& resref, const QModelIndex& index) const;
+
+    QString cache_tag_;
+    Transform transform_;
+    mutable QHash<QString, QList<QPersistentModelIndex>> pending_;
+    mutable QSet<QString> failed_;
+};
@@ -0,0 +1,198 @@
+#include "resourcecatalogue.h"
+
+#include <nw/kernel/Resources.hpp>
+#include <nw/log.hpp>
+
+#include <QElapsedTimer>
+#include <QtConcurrent/QtConcurrent>
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+
+namespace {
+
+// Resources are parsed in chunks of this size on the global thread pool.
+constexpr size_t catalogue_chunk_size = 4096;
+
+bool is_lower_alpha(char c) { return c >= 'a' && c <= 'z'; }
+bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+// Parses a trailing ``_nnn``, returns the number or -1.
+int parse_number_suffix(std::string_view name)
+{
+    if (name.size() < 5 || name[name.size() - 4] != '_') { return -1; }
+    auto digits = name.substr(name.size() - 3);
+    if (!std::all_of(digits.begin(), digits.end(), is_digit)) { return -1; }
+    return (digits[0] - '0') * 100 + (digits[1] - '0') * 10 + (digits[2] - '0');
+}
+
+// Parses a part model resref, e.g. ``pfh0_chest001``: p, gender, race, phenotype, '_', part, 3 digit number.
+bool parse_part_model(std::string_view name, PartModelKey& key, int& number)
+{
+    if (name.size() < 9 || name[0] != 'p' || (name[1] != 'm' && name[1] != 'f') || !is_lower_alpha(name[2])) {
+        return false;
+    }
+
+    size_t pos = 3;
+    while (pos < name.size() && is_digit(name[pos])) {
+        ++pos;
+    }
+    if (pos == 3 || pos >= name.size() || name[pos] != '_') { return false; }
+
+    auto [ptr, ec] = std::from_chars(name.data() + 3, name.data() + pos, key.phenotype);
+    if (ec != std::errc{}) { return false; }
+
+    auto part = name.substr(pos + 1);
+    if (part.size() < 4) { return false; }
+    auto digits = part.substr(part.size() - 3);
+    part.remove_suffix(3);
+    if (!std::all_of(part.begin(), part.end(), is_lower_alpha)
+        || !std::all_of(digits.begin(), digits.end(), is_digit)) {
+        return false;
+    }
+
+    key.part = nw::String{part};
+    key.race = char(std::toupper(name[2]));
+    key.female = name[1] == 'f';
+    number = (digits[0] - '0') * 100 + (digits[1] - '0') * 10 + (digits[2] - '0');
+    return true;
+}
+
+void sort_unique(std::vector<int>& values)
+{
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+}
+
+void append(std::vector<int>& to, const std::vector<int>& from)
+{
+    to.insert(to.end(), from.begin(), from.end());
+}
+
+} // namespace
+
+void ResourceCatalogue::build()
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    std::vector<nw::Resource> resources;
+    nw::kernel::resman().visit([&resources](const nw::Resource& res) { resources.push_back(res); },
+        {nw::ResourceType::mdl, nw::ResourceType::dds, nw::ResourceType::tga});
+
+    std::vector<std::pair<size_t, size_t>> chunks;
+    for (size_t i = 0; i < resources.size(); i += catalogue_chunk_size) {
+        chunks.emplace_back(i, std::min(resources.size(), i + catalogue_chunk_size));
+    }
+
+    auto parse = [&resources](const std::pair<size_t, size_t>& range) {
+        ResourceCatalogue result;
+        for (size_t i = range.first; i < range.second; ++i) {
+            result.add(resources[i]);
+        }
+        return result;
+    };
+    auto reduce = [](ResourceCatalogue& result, const ResourceCatalogue& partial) {
+        result.merge(partial);
+    };
+
+    *this = QtConcurrent::blockingMappedReduced<ResourceCatalogue>(chunks, parse, reduce,
+        QtConcurrent::UnorderedReduce);
+    finalize();
+
+    LOG_F(INFO, "[toolset] catalogued {} resources in {}ms, {} body parts, {} model prefixes, {} texture prefixes",
+        resources.size(), timer.elapsed(), body_parts_.size(), models_.size(), textures_.size());
+}
+
+const std::vector<int>& ResourceCatalogue::body_parts(const PartModelKey& key) const
+{
+    static const std::vector<int> empty;
+    auto it = body_parts_.find(key);
+    return it != std::end(body_parts_) ? it->second : empty;
+}
+
+const ItemModelEntry* ResourceCatalogue::items(std::string_view prefix, bool mdl) const
+{
+    const auto& map = mdl ? models_ : textures_;
+    auto it = map.find(prefix);
+    return it != std::end(map) ? &it->second : nullptr;
+}
+
+void ResourceCatalogue::add(const nw::Resource& res)
+{
+    auto name = res.resref.view();
+    bool mdl = res.type == nw::ResourceType::mdl;
+
+    if (mdl) {
+        PartModelKey key;
+        int number = 0;
+        if (parse_part_model(name, key, number)) {
+            body_parts_[std::move(key)].push_back(number);
+            return;
+        }
+    }
+
+    int number = parse_number_suffix(name);
+    if (number < 0) { return; }
+
+    auto& map = mdl ? models_ : textures_;
+    auto prefix = name.substr(0, name.size() - 4);
+    map[prefix].simple.push_back(number);
+
+    // Composite parts, e.g. wswls_b_011
+    if (prefix.size() >= 3 && prefix[prefix.size() - 2] == '_') {
+        int part = -1;
+        switch (prefix.back()) {
+        case 't':
+            part = 0;
+            break;
+        case 'm':
+            part = 1;
+            break;
+        case 'b':
+            part = 2;
+            break;
+        }
+        if (part >= 0) {
+            map[prefix.substr(0, prefix.size() - 2)].parts[size_t(part)].push_back(number);
+        }
+    }
+}
+
+void ResourceCatalogue::merge(const ResourceCatalogue& other)
+{
+    for (const auto& [key, numbers] : other.body_parts_) {
+        append(body_parts_[key], numbers);
+    }
+
+    auto merge_items = [](auto& to, const auto& from) {
+        for (const auto& [prefix, entry] : from) {
+            auto& dest = to[prefix];
+            append(dest.simple, entry.simple);
+            for (size_t i = 0; i < entry.parts.size(); ++i) {
+                append(dest.parts[i], entry.parts[i]);
+            }
+        }
+    };
+    merge_items(models_, other.models_);
+    merge_items(textures_, other.textures_);
+}
+
+void ResourceCatalogue::finalize()
+{
+    for (auto& [_, numbers] : body_parts_) {
+        sort_unique(numbers);
+    }
+
+    auto finalize_items = [](auto& map) {
+        for (auto& [_, entry] : map) {
+            sort_unique(entry.simple);
+            for (auto& part : entry.parts) {
+                sort_unique(part);
+            }
+        }
+    };
+    finalize_items(models_);
+    finalize_items(textures_);
+}
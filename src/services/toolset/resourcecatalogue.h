@@ -0,0 +1,58 @@
+#pragma once
+
+#include <nw/config.hpp>
+#include <nw/resources/Resource.hpp>
+
+#include <absl/container/flat_hash_map.h>
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// Key into the body part model index, i.e. ``pmh0_chest`` from ``pmh0_chest001.mdl``
+struct PartModelKey {
+    nw::String part;
+    char race = 'H';
+    int phenotype = 0;
+    bool female = false;
+
+    bool operator==(const PartModelKey&) const noexcept = default;
+
+    template <typename H>
+    friend H AbslHashValue(H h, const PartModelKey& key)
+    {
+        return H::combine(std::move(h), key.part, key.race, key.phenotype, key.female);
+    }
+};
+
+/// Numbered resources found under an item prefix, e.g. ``wswls``
+struct ItemModelEntry {
+    std::vector<int> simple;               ///< ``<prefix>_<nnn>``
+    std::array<std::vector<int>, 3> parts; ///< ``<prefix>_<t|m|b>_<nnn>``, indexed top, middle, bottom
+};
+
+/// Catalogue of model and texture resources that follow the part and item naming conventions.
+///
+/// Built in a single pass over the resource manager so lookups never need to scan it again,
+/// all number lists are sorted and unique.
+class ResourceCatalogue {
+public:
+    /// Rebuilds the catalogue from all mdl, dds and tga resources
+    void build();
+
+    /// Gets part numbers for a body part
+    const std::vector<int>& body_parts(const PartModelKey& key) const;
+
+    /// Gets models, if ``mdl``, or textures with ``prefix``, returns nullptr if there are none
+    const ItemModelEntry* items(std::string_view prefix, bool mdl) const;
+
+private:
+    void add(const nw::Resource& res);
+    void merge(const ResourceCatalogue& other);
+    void finalize();
+
+    absl::flat_hash_map<PartModelKey, std::vector<int>> body_parts_;
+    absl::flat_hash_map<std::string, ItemModelEntry> models_;
+    absl::flat_hash_map<std::string, ItemModelEntry> textures_;
+};
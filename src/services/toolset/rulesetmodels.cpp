@@ -10,6 +10,7 @@ RuleFilterProxyModel::RuleFilterProxyModel(QObject* parent)
     : QSortFilterProxyModel(parent)
 {
     setDynamicSortFilter(true);
+    setSortRole(CollationRankRole);
     sort(0);
 }
 
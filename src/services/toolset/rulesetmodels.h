@@ -3,6 +3,7 @@
 #include <nw/config.hpp>
 #include <nw/resources/Resref.hpp>
 
+#include "../../widgets/statictwodamodel.h"
 #include "../../widgets/util/strings.h"
 
 #include <QAbstractItemModel>
@@ -56,19 +57,40 @@ struct RuleTypeModel : public QAbstractItemModel {
             break;
         case Qt::DisplayRole:
             if (info.valid()) {
-                return to_qstring(info.editor_name());
+                build_cache();
+                return names_[index.row()];
             }
             break;
         case Qt::UserRole + 1:
             return index.row();
         case Qt::UserRole + 2:
             return info.valid();
+        case CollationRankRole:
+            build_cache();
+            return ranks_[index.row()];
         }
         return {};
     }
 
 private:
+    // Display strings and their collation ranks are built once, so sorting never
+    // converts or compares strings.
+    void build_cache() const
+    {
+        if (cached_) { return; }
+        names_.clear();
+        names_.reserve(qsizetype(entries_->size()));
+        for (const auto& info : *entries_) {
+            names_.append(info.valid() ? to_qstring(info.editor_name()) : QString{});
+        }
+        ranks_ = collation_ranks(names_);
+        cached_ = true;
+    }
+
     nw::PVector<T>* entries_;
+    mutable QList<QString> names_;
+    mutable QList<int> ranks_;
+    mutable bool cached_ = false;
 };
 
 class RuleFilterProxyModel : public QSortFilterProxyModel {
@@ -1,5 +1,9 @@
 #include "toolsetservice.h"
 
+#include "lazyiconmodel.h"
+
+#include "../trace/trace.h"
+
 #include "nw/kernel/FactionSystem.hpp"
 #include "nw/kernel/Resources.hpp"
 #include "nw/kernel/Rules.hpp"
@@ -9,13 +13,17 @@
 #include <absl/container/btree_map.h>
 #include <absl/container/btree_set.h>
 
-#include <regex>
 
 #include <QCoreApplication>
+#include <QElapsedTimer>
 #include <QObject>
 #include <QPainter>
 #include <QStandardItemModel>
 #include <QStringListModel>
+#include <QtConcurrent/QtConcurrent>
+
+#include <algorithm>
+#include <functional>
 
 QImage merge_loadscreen_image(const QImage& image)
 {
@@ -40,6 +48,42 @@ QImage merge_loadscreen_image(const QImage& image)
     return result;
 }
 
+namespace {
+
+// A row of a QStandardItemModel, read from the kernel before the model is built
+struct ItemRow {
+    QString text;
+    int id = 0;
+    QVariant extra;
+};
+
+struct ToolsetInitStage {
+    const char* name;
+    /// Runs on the calling thread, reads what the stage needs from the kernel and creates its models
+    std::function<void(ToolsetInitStage&)> read;
+    /// Runs on the thread pool, fills the stage's models from ``rows``
+    std::function<void(ToolsetInitStage&)> build;
+    std::vector<ItemRow> rows;
+    qint64 read_ms = 0;
+    qint64 build_ms = 0;
+};
+
+// Appends ``rows`` in a single insert, ids go in Qt::UserRole + 1 and extras in ``extra_role``
+void append_rows(QStandardItemModel* model, const std::vector<ItemRow>& rows, int extra_role = Qt::UserRole + 2)
+{
+    QList<QStandardItem*> items;
+    items.reserve(qsizetype(rows.size()));
+    for (const auto& row : rows) {
+        auto item = new QStandardItem(row.text);
+        item->setData(row.id);
+        if (row.extra.isValid()) { item->setData(row.extra, extra_role); }
+        items.append(item);
+    }
+    model->invisibleRootItem()->appendRows(items);
+}
+
+} // namespace
+
 const std::type_index ToolsetService::type_index{typeid(ToolsetService)};
 
 ToolsetService::ToolsetService(nw::MemoryResource* memory)
@@ -58,349 +102,360 @@ void ToolsetService::initialize(nw::kernel::ServiceInitTime time)
         return;
     }
     LOG_F(INFO, "[toolset] initializing service");
+    TRACE_SCOPE("ToolsetService::initialize");
+
+    QElapsedTimer total;
+    total.start();
+
+    // The 2da cache, tlk lookups and resman aren't safe to use concurrently, so every stage reads on this
+    // thread. Rule and 2da models read strings as they sort, they're built entirely in their read.
+    std::vector<ToolsetInitStage> stages;
+
+    stages.push_back({"resource catalogue", [this](ToolsetInitStage&) {
+        catalogue.build();
+    }});
+
+    stages.push_back({"appearances", [this](ToolsetInitStage&) {
+        appearances_model.reset(new RuleTypeModel<nw::AppearanceInfo>(&nw::kernel::rules().appearances.entries));
+        appearances_filter.reset(new RuleFilterProxyModel());
+        appearances_filter->setSourceModel(appearances_model.get());
+        appearances_filter->sort(0);
+    }});
+
+    stages.push_back({"baseitems", [this](ToolsetInitStage&) {
+        baseitem_model.reset(new RuleTypeModel<nw::BaseItemInfo>(&nw::kernel::rules().baseitems.entries));
+        baseitem_filter.reset(new RuleFilterProxyModel());
+        baseitem_filter->setSourceModel(baseitem_model.get());
+        baseitem_filter->sort(0);
+    }});
+
+    stages.push_back({"classes", [this](ToolsetInitStage&) {
+        class_model.reset(new RuleTypeModel<nw::ClassInfo>(&nw::kernel::rules().classes.entries));
+        class_filter.reset(new RuleFilterProxyModel());
+        class_filter->setSourceModel(class_model.get());
+        class_filter->sort(0);
+    }});
+
+    stages.push_back({"doortypes", [this](ToolsetInitStage&) {
+        auto doortypes = nw::kernel::twodas().get("doortypes");
+        auto name_col = int(doortypes->column_index("StringRefGame"));
+        doortypes_model.reset(new StaticTwoDAModel(doortypes, name_col));
+        doortypes_model->setColumns({name_col});
+        doortypes_filter = std::make_unique<EmptyFilterProxyModel>(0);
+        doortypes_filter->setSourceModel(doortypes_model.get());
+        doortypes_filter->setSortRole(CollationRankRole);
+    }});
+
+    stages.push_back({"genericdoors", [this](ToolsetInitStage&) {
+        auto genericdoors = nw::kernel::twodas().get("genericdoors");
+        auto name_col = int(genericdoors->column_index("Name"));
+        genericdoors_model = std::make_unique<StaticTwoDAModel>(genericdoors, name_col);
+        genericdoors_model->setColumns({name_col});
+        genericdoors_filter = std::make_unique<EmptyFilterProxyModel>(0);
+        genericdoors_filter->setSourceModel(genericdoors_model.get());
+        genericdoors_filter->setSortRole(CollationRankRole);
+        genericdoors_filter->sort(0);
+    }});
+
+    stages.push_back({"loadscreens",
+        [this](ToolsetInitStage& stage) {
+            std::string temp_string;
+            int temp_int;
+            auto loadscreens = nw::kernel::twodas().get("loadscreens");
+            for (size_t i = 0; i < loadscreens->rows(); ++i) {
+                QString name;
+                if (loadscreens->get_to(i, "StrRef", temp_int)) {
+                    name = to_qstring(nw::kernel::strings().get(temp_int));
+                } else if (loadscreens->get_to(i, "Label", temp_string)) {
+                    name = to_qstring(temp_string);
+                }
+                if (name.isEmpty()) { continue; }
 
-    // Load all part models
-    auto model_filter = [this](const nw::Resource& res) {
-        static std::regex pattern(R"(p([mf])([a-z])([0-9]+)_([a-z]+)(\d{3})\.mdl)");
-        static std::string filename;
-
-        filename = res.filename();
-        std::smatch matches;
-        if (std::regex_match(filename, matches, pattern)) {
-            body_part_models.push_back(
-                PartModels{
-                    .part = matches[4].str(),
-                    .race = char(std::toupper(matches[2].str()[0])),
-                    .phenotype = std::stoi(matches[3].str()),
-                    .female = matches[1].str()[0] == 'f',
-                    .number = std::stoi(matches[5].str()),
-                });
-        }
+                if (!loadscreens->get_to(i, "BMPResRef", temp_string)) { continue; }
+                stage.rows.push_back({name, int(i), to_qstring(temp_string)});
+            }
+            loadscreens_model = std::make_unique<LazyIconModel>("loadscreen:", merge_loadscreen_image);
+        },
+        [this](ToolsetInitStage& stage) {
+            append_rows(loadscreens_model.get(), stage.rows, LazyIconModel::ResrefRole);
+        }});
+
+    stages.push_back({"phenotypes", [this](ToolsetInitStage&) {
+        phenotype_model.reset(new RuleTypeModel<nw::PhenotypeInfo>(&nw::kernel::rules().phenotypes.entries));
+        phenotype_filter.reset(new RuleFilterProxyModel());
+        phenotype_filter->setSourceModel(phenotype_model.get());
+        phenotype_filter->sort(-1);
+    }});
+
+    stages.push_back({"placeables", [this](ToolsetInitStage&) {
+        placeable_model.reset(new RuleTypeModel<nw::PlaceableInfo>(&nw::kernel::rules().placeables.entries));
+        placeable_filter.reset(new RuleFilterProxyModel());
+        placeable_filter->setSourceModel(placeable_model.get());
+        placeable_filter->sort(0);
+    }});
+
+    stages.push_back({"races", [this](ToolsetInitStage&) {
+        race_model.reset(new RuleTypeModel<nw::RaceInfo>(&nw::kernel::rules().races.entries));
+        race_filter.reset(new RuleFilterProxyModel());
+        race_filter->setSourceModel(race_model.get());
+        race_filter->sort(0);
+    }});
+
+    stages.push_back({"factions",
+        [this](ToolsetInitStage& stage) {
+            for (auto& faction : nw::kernel::factions().all()) {
+                stage.rows.push_back({to_qstring(faction), int(nw::kernel::factions().faction_id(faction))});
+            }
+            faction_model = std::make_unique<QStandardItemModel>();
+        },
+        [this](ToolsetInitStage& stage) {
+            append_rows(faction_model.get(), stage.rows);
+        }});
+
+    stages.push_back({"traps", [this](ToolsetInitStage&) {
+        trap_model = std::make_unique<RuleTypeModel<nw::TrapInfo>>(&nw::kernel::rules().traps.entries);
+        trap_filter = std::make_unique<RuleFilterProxyModel>();
+        trap_filter->setSourceModel(trap_model.get());
+    }});
+
+    stages.push_back({"creaturespeed",
+        [this](ToolsetInitStage& stage) {
+            auto creaturespeed = nw::kernel::twodas().get("creaturespeed");
+            for (size_t i = 0; i < creaturespeed->rows(); ++i) {
+                int temp;
+                if (creaturespeed->get_to(i, "Name", temp)) {
+                    stage.rows.push_back({to_qstring(nw::kernel::strings().get(temp)), int(i)});
+                }
+            }
+            creaturespeed_model = std::make_unique<QStandardItemModel>();
+        },
+        [this](ToolsetInitStage& stage) {
+            append_rows(creaturespeed_model.get(), stage.rows);
+            creaturespeed_model->sort(0);
+        }});
+
+    stages.push_back({"packages",
+        [this](ToolsetInitStage& stage) {
+            auto packages = nw::kernel::twodas().get("packages");
+            for (size_t i = 0; i < packages->rows(); ++i) {
+                int name, package_class;
+                if (packages->get_to(i, "Name", name)
+                    && packages->get_to(i, "ClassID", package_class)) {
+                    stage.rows.push_back({to_qstring(nw::kernel::strings().get(name)), int(i), package_class});
+                }
+            }
+            packages_model = std::make_unique<QStandardItemModel>();
+        },
+        [this](ToolsetInitStage& stage) {
+            append_rows(packages_model.get(), stage.rows, Qt::UserRole + 2);
+            packages_model->sort(0);
+        }});
+
+    stages.push_back({"ranges",
+        [this](ToolsetInitStage& stage) {
+            auto ranges = nw::kernel::twodas().get("ranges");
+            for (size_t i = 0; i < ranges->rows(); ++i) {
+                int temp;
+                if (ranges->get_to(i, "Name", temp)) {
+                    stage.rows.push_back({to_qstring(nw::kernel::strings().get(temp)), int(i)});
+                }
+            }
+            ranges_model = std::make_unique<QStandardItemModel>();
+        },
+        [this](ToolsetInitStage& stage) {
+            append_rows(ranges_model.get(), stage.rows);
+            ranges_model->sort(0);
+        }});
+
+    stages.push_back({"sounds", [this](ToolsetInitStage&) {
+        sound_model = std::make_unique<SoundModel>();
+    }});
+
+    auto add_label_stage = [&stages](const char* name, const char* twoda, std::unique_ptr<QStandardItemModel>& model) {
+        stages.push_back({name,
+            [twoda, &model](ToolsetInitStage& stage) {
+                std::string temp_string;
+                auto tda = nw::kernel::twodas().get(twoda);
+                stage.rows.push_back({"-- None --", 0});
+                for (size_t i = 1; i < tda->rows(); ++i) {
+                    if (!tda->get_to(i, "LABEL", temp_string) || temp_string.empty()) { continue; }
+                    stage.rows.push_back({to_qstring(temp_string), int(i)});
+                }
+                model = std::make_unique<QStandardItemModel>();
+            },
+            [&model](ToolsetInitStage& stage) {
+                append_rows(model.get(), stage.rows);
+                model->sort(0, Qt::AscendingOrder);
+            }});
     };
-    nw::kernel::resman().visit(model_filter, {nw::ResourceType::mdl});
-    std::sort(body_part_models.begin(), body_part_models.end());
-
-    appearances_model.reset(new RuleTypeModel<nw::AppearanceInfo>(&nw::kernel::rules().appearances.entries));
-    appearances_filter.reset(new RuleFilterProxyModel());
-    appearances_filter->setSourceModel(appearances_model.get());
-    appearances_filter->sort(0);
-    appearances_model->moveToThread(QCoreApplication::instance()->thread());
-    appearances_filter->moveToThread(QCoreApplication::instance()->thread());
-
-    baseitem_model.reset(new RuleTypeModel<nw::BaseItemInfo>(&nw::kernel::rules().baseitems.entries));
-    baseitem_filter.reset(new RuleFilterProxyModel());
-    baseitem_filter->setSourceModel(baseitem_model.get());
-    baseitem_filter->sort(0);
-    baseitem_model->moveToThread(QCoreApplication::instance()->thread());
-    baseitem_filter->moveToThread(QCoreApplication::instance()->thread());
-
-    class_model.reset(new RuleTypeModel<nw::ClassInfo>(&nw::kernel::rules().classes.entries));
-    class_filter.reset(new RuleFilterProxyModel());
-    class_filter->setSourceModel(class_model.get());
-    class_filter->sort(0);
-    class_model->moveToThread(QCoreApplication::instance()->thread());
-    class_filter->moveToThread(QCoreApplication::instance()->thread());
-
-    auto doortypes = nw::kernel::twodas().get("doortypes");
-    auto name_col = int(doortypes->column_index("StringRefGame"));
-    doortypes_model.reset(new StaticTwoDAModel(doortypes, name_col));
-    doortypes_model->setColumns({name_col});
-    doortypes_filter = std::make_unique<EmptyFilterProxyModel>(0);
-    doortypes_filter->setSourceModel(doortypes_model.get());
-    doortypes_model->moveToThread(QCoreApplication::instance()->thread());
-    doortypes_filter->moveToThread(QCoreApplication::instance()->thread());
-
-    auto genericdoors = nw::kernel::twodas().get("genericdoors");
-    name_col = int(genericdoors->column_index("Name"));
-    genericdoors_model = std::make_unique<StaticTwoDAModel>(genericdoors, name_col);
-    genericdoors_model->setColumns({name_col});
-    genericdoors_filter = std::make_unique<EmptyFilterProxyModel>(0);
-    genericdoors_filter->setSourceModel(genericdoors_model.get());
-    genericdoors_filter->sort(0);
-    genericdoors_model->moveToThread(QCoreApplication::instance()->thread());
-    genericdoors_filter->moveToThread(QCoreApplication::instance()->thread());
-
-    std::string temp_string;
-    int temp_int;
-    auto loadscreens = nw::kernel::twodas().get("loadscreens");
-    loadscreens_model = std::make_unique<QStandardItemModel>();
-    for (size_t i = 0; i < loadscreens->rows(); ++i) {
-        QString name;
-        if (loadscreens->get_to(i, "StrRef", temp_int)) {
-            name = to_qstring(nw::kernel::strings().get(temp_int));
-        } else if (loadscreens->get_to(i, "Label", temp_string)) {
-            name = to_qstring(temp_string);
-        }
-        if (name.isEmpty()) { continue; }
-
-        if (!loadscreens->get_to(i, "BMPResRef", temp_string)) { continue; }
-
-        auto resref = nw::Resref{temp_string};
-        auto item = new QStandardItem(name);
-        auto rdata = nw::kernel::resman().demand_in_order(nw::Resref(resref),
-            {nw::ResourceType::dds, nw::ResourceType::tga});
-
-        if (rdata.bytes.size()) {
-            nw::Image icon{std::move(rdata)};
-            QImage image(icon.release(), icon.width(), icon.height(), icon.channels() == 4 ? QImage::Format_RGBA8888 : QImage::Format_RGB888,
-                [](void* bytes) { if (bytes) { free(bytes); } });
-
-            // stb automatically flips standard dds and tga,
-            // so here for bioware dds which is implemented a bit differently
-            // needs to be flipped back to right side up.
-            if (icon.is_bio_dds()) {
-                image.mirror();
+    add_label_stage("tails", "tailmodel", tails_model);
+    add_label_stage("wings", "wingmodel", wings_model);
+
+    stages.push_back({"waypoints",
+        [this](ToolsetInitStage& stage) {
+            int temp_int;
+            auto waypoint_2da = nw::kernel::twodas().get("waypoint");
+            for (size_t i = 1; i < waypoint_2da->rows(); ++i) {
+                if (!waypoint_2da->get_to(i, "strref", temp_int)) { continue; }
+                stage.rows.push_back({to_qstring(nw::kernel::strings().get(uint32_t(temp_int))), int(i)});
             }
-
-            image = merge_loadscreen_image(image);
-            item->setIcon(QIcon(QPixmap::fromImage(image)));
-        }
-
-        item->setData(int(i));
-        loadscreens_model->appendRow(item);
-    }
-    loadscreens_model->moveToThread(QCoreApplication::instance()->thread());
-
-    phenotype_model.reset(new RuleTypeModel<nw::PhenotypeInfo>(&nw::kernel::rules().phenotypes.entries));
-    phenotype_filter.reset(new RuleFilterProxyModel());
-    phenotype_filter->setSourceModel(phenotype_model.get());
-    phenotype_filter->sort(-1);
-    phenotype_model->moveToThread(QCoreApplication::instance()->thread());
-    phenotype_filter->moveToThread(QCoreApplication::instance()->thread());
-
-    placeable_model.reset(new RuleTypeModel<nw::PlaceableInfo>(&nw::kernel::rules().placeables.entries));
-    placeable_filter.reset(new RuleFilterProxyModel());
-    placeable_filter->setSourceModel(placeable_model.get());
-    placeable_filter->sort(0);
-    placeable_model->moveToThread(QCoreApplication::instance()->thread());
-    placeable_filter->moveToThread(QCoreApplication::instance()->thread());
-
-    race_model.reset(new RuleTypeModel<nw::RaceInfo>(&nw::kernel::rules().races.entries));
-    race_filter.reset(new RuleFilterProxyModel());
-    race_filter->setSourceModel(race_model.get());
-    race_filter->sort(0);
-    race_model->moveToThread(QCoreApplication::instance()->thread());
-    race_filter->moveToThread(QCoreApplication::instance()->thread());
-
-    faction_model = std::make_unique<QStandardItemModel>();
-    for (auto& faction : nw::kernel::factions().all()) {
-        auto item = new QStandardItem(to_qstring(faction));
-        item->setData(nw::kernel::factions().faction_id(faction));
-        faction_model->appendRow(item);
-    }
-
-    trap_model = std::make_unique<RuleTypeModel<nw::TrapInfo>>(&nw::kernel::rules().traps.entries);
-    trap_model->moveToThread(QCoreApplication::instance()->thread());
-    trap_filter = std::make_unique<RuleFilterProxyModel>();
-    trap_filter->setSourceModel(trap_model.get());
-    trap_filter->moveToThread(QCoreApplication::instance()->thread());
-
-    auto creaturespeed = nw::kernel::twodas().get("creaturespeed");
-    creaturespeed_model = std::make_unique<QStandardItemModel>();
-    for (size_t i = 0; i < creaturespeed->rows(); ++i) {
-        int temp;
-        if (creaturespeed->get_to(i, "Name", temp)) {
-            auto item = new QStandardItem(to_qstring(nw::kernel::strings().get(temp)));
-            item->setData(int(i));
-            creaturespeed_model->appendRow(item);
-        }
-    }
-    creaturespeed_model->sort(0);
-    creaturespeed_model->moveToThread(QCoreApplication::instance()->thread());
-
-    auto packages = nw::kernel::twodas().get("packages");
-    packages_model = std::make_unique<QStandardItemModel>();
-    for (size_t i = 0; i < packages->rows(); ++i) {
-        int name, package_class;
-        if (packages->get_to(i, "Name", name)
-            && packages->get_to(i, "ClassID", package_class)) {
-            auto item = new QStandardItem(to_qstring(nw::kernel::strings().get(name)));
-            item->setData(int(i), Qt::UserRole + 1);
-            item->setData(package_class, Qt::UserRole + 2);
-            packages_model->appendRow(item);
-        }
-    }
-    packages_model->sort(0);
-    packages_model->moveToThread(QCoreApplication::instance()->thread());
-
-    auto ranges = nw::kernel::twodas().get("ranges");
-    ranges_model = std::make_unique<QStandardItemModel>();
-    for (size_t i = 0; i < ranges->rows(); ++i) {
-        int temp;
-        if (ranges->get_to(i, "Name", temp)) {
-            auto item = new QStandardItem(to_qstring(nw::kernel::strings().get(temp)));
-            item->setData(int(i));
-            ranges_model->appendRow(item);
-        }
-    }
-    ranges_model->sort(0);
-    ranges_model->moveToThread(QCoreApplication::instance()->thread());
-
-    sound_model = std::make_unique<SoundModel>();
-    sound_model->moveToThread(QCoreApplication::instance()->thread());
-
-    auto tailmodel_2da = nw::kernel::twodas().get("tailmodel");
-    tails_model = std::make_unique<QStandardItemModel>();
-
-    {
-        auto item = new QStandardItem("-- None --");
-        item->setData(0);
-        tails_model->appendRow(item);
-    }
-
-    for (size_t i = 1; i < tailmodel_2da->rows(); ++i) {
-        if (!tailmodel_2da->get_to(i, "LABEL", temp_string) || temp_string.empty()) { continue; }
-        auto item = new QStandardItem(to_qstring(temp_string));
-        item->setData(int(i));
-        tails_model->appendRow(item);
-    }
-    tails_model->sort(0, Qt::AscendingOrder);
-    tails_model->moveToThread(QCoreApplication::instance()->thread());
-
-    auto wingmodel_2da = nw::kernel::twodas().get("wingmodel");
-    wings_model = std::make_unique<QStandardItemModel>();
-
-    {
-        auto item = new QStandardItem("-- None --");
-        item->setData(0);
-        wings_model->appendRow(item);
+            waypoint_model = std::make_unique<QStandardItemModel>();
+        },
+        [this](ToolsetInitStage& stage) {
+            append_rows(waypoint_model.get(), stage.rows);
+        }});
+
+    stages.push_back({"genders", [this](ToolsetInitStage&) {
+        gender_basic_model.reset(new QStringListModel());
+        gender_basic_model->setStringList(QStringList()
+            << QStringListModel::tr("Male")
+            << QStringListModel::tr("Female"));
+    }});
+
+    stages.push_back({"dynamic appearances",
+        [this](ToolsetInitStage& stage) {
+            for (size_t i = 0; i < nw::kernel::rules().appearances.entries.size(); ++i) {
+                const auto& app = nw::kernel::rules().appearances.entries[i];
+                if (!app.valid()) { continue; }
+                if (nw::string::icmp(app.model_type, "P")) {
+                    stage.rows.push_back({to_qstring(app.editor_name()), int(i)});
+                }
+            }
+            dynamic_appearance_model.reset(new QStandardItemModel());
+        },
+        [this](ToolsetInitStage& stage) {
+            append_rows(dynamic_appearance_model.get(), stage.rows);
+            dynamic_appearance_model->sort(-1);
+        }});
+
+    stages.push_back({"cloaks",
+        [this](ToolsetInitStage& stage) {
+            if (auto cloakmodel = nw::kernel::twodas().get("cloakmodel")) {
+                std::string name;
+                for (size_t i = 0; i < cloakmodel->rows(); ++i) {
+                    if (cloakmodel->get_to(i, "LABEL", name)) {
+                        stage.rows.push_back({to_qstring(name), int(i)});
+                    }
+                }
+            }
+            cloak_model.reset(new QStandardItemModel);
+        },
+        [this](ToolsetInitStage& stage) {
+            append_rows(cloak_model.get(), stage.rows);
+            cloak_model->sort(0);
+        }});
+
+    // Each part 2da is its own stage, there are a dozen of them and they're all independent.
+    auto add_part_stage = [&stages](const char* twoda, std::unique_ptr<QStandardItemModel>& model) {
+        stages.push_back({twoda,
+            [twoda, &model](ToolsetInitStage& stage) {
+                model.reset(new QStandardItemModel);
+                auto tda = nw::kernel::twodas().get(twoda);
+                if (!tda) { return; }
+                float temp;
+                size_t col = tda->column_index("ACBONUS");
+                if (col == nw::StaticTwoDA::npos) { return; }
+
+                for (size_t i = 0; i < tda->rows(); ++i) {
+                    if (tda->get_to(i, col, temp)) {
+                        stage.rows.push_back({QString::number(i), int(i)});
+                    }
+                }
+            },
+            [&model](ToolsetInitStage& stage) {
+                append_rows(model.get(), stage.rows);
+            }});
+    };
+    add_part_stage("parts_belt", parts_belt);
+    add_part_stage("parts_bicep", parts_bicep);
+    add_part_stage("parts_chest", parts_chest);
+    add_part_stage("parts_foot", parts_foot);
+    add_part_stage("parts_forearm", parts_forearm);
+    add_part_stage("parts_hand", parts_hand);
+    add_part_stage("parts_legs", parts_legs);
+    add_part_stage("parts_neck", parts_neck);
+    add_part_stage("parts_pelvis", parts_pelvis);
+    add_part_stage("parts_robe", parts_robe);
+    add_part_stage("parts_shin", parts_shin);
+    add_part_stage("parts_shoulder", parts_shoulder);
+
+    for (auto& stage : stages) {
+        TraceScope scope{stage.name, "toolset"};
+        QElapsedTimer timer;
+        timer.start();
+        stage.read(stage);
+        stage.read_ms = timer.elapsed();
     }
 
-    for (size_t i = 1; i < wingmodel_2da->rows(); ++i) {
-        if (!wingmodel_2da->get_to(i, "LABEL", temp_string) || temp_string.empty()) { continue; }
-        auto item = new QStandardItem(to_qstring(temp_string));
-        item->setData(int(i));
-        wings_model->appendRow(item);
+    // Builds only touch their own rows and models, none of them call into the kernel.
+    QtConcurrent::blockingMap(stages, [](ToolsetInitStage& stage) {
+        if (!stage.build) { return; }
+        TraceScope scope{stage.name, "toolset"};
+        QElapsedTimer timer;
+        timer.start();
+        stage.build(stage);
+        stage.build_ms = timer.elapsed();
+    });
+
+    // Every model was created on this thread, which is the only one that can push them to the GUI thread.
+    auto gui_thread = QCoreApplication::instance()->thread();
+    for (QObject* model : std::initializer_list<QObject*>{
+             appearances_model.get(), appearances_filter.get(),
+             baseitem_model.get(), baseitem_filter.get(),
+             class_model.get(), class_filter.get(),
+             doortypes_model.get(), doortypes_filter.get(),
+             genericdoors_model.get(), genericdoors_filter.get(),
+             loadscreens_model.get(),
+             phenotype_model.get(), phenotype_filter.get(),
+             placeable_model.get(), placeable_filter.get(),
+             race_model.get(), race_filter.get(),
+             faction_model.get(),
+             trap_model.get(), trap_filter.get(),
+             creaturespeed_model.get(), packages_model.get(), ranges_model.get(), sound_model.get(),
+             tails_model.get(), wings_model.get(), waypoint_model.get(),
+             gender_basic_model.get(), dynamic_appearance_model.get(), cloak_model.get(),
+             parts_belt.get(), parts_bicep.get(), parts_chest.get(), parts_foot.get(),
+             parts_forearm.get(), parts_hand.get(), parts_legs.get(), parts_neck.get(),
+             parts_pelvis.get(), parts_robe.get(), parts_shin.get(), parts_shoulder.get()}) {
+        model->moveToThread(gui_thread);
     }
-    wings_model->sort(0, Qt::AscendingOrder);
-    wings_model->moveToThread(QCoreApplication::instance()->thread());
 
-    auto waypoint_2da = nw::kernel::twodas().get("waypoint");
-    waypoint_model = std::make_unique<QStandardItemModel>();
+    std::sort(stages.begin(), stages.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.read_ms + lhs.build_ms > rhs.read_ms + rhs.build_ms;
+    });
 
-    for (size_t i = 1; i < waypoint_2da->rows(); ++i) {
-        if (!waypoint_2da->get_to(i, "strref", temp_int)) { continue; }
-        auto item = new QStandardItem(to_qstring(nw::kernel::strings().get(uint32_t(temp_int))));
-        item->setData(int(i));
-        waypoint_model->appendRow(item);
+    LOG_F(INFO, "[toolset] initialized in {}ms", total.elapsed());
+    for (const auto& stage : stages) {
+        LOG_F(INFO, "[toolset]   {:<20} {:>6}ms read {:>6}ms build", stage.name, stage.read_ms, stage.build_ms);
     }
-    waypoint_model->moveToThread(QCoreApplication::instance()->thread());
-
-    gender_basic_model.reset(new QStringListModel());
-    gender_basic_model->setStringList(QStringList()
-        << QStringListModel::tr("Male")
-        << QStringListModel::tr("Female"));
-    gender_basic_model->moveToThread(QCoreApplication::instance()->thread());
-
-    dynamic_appearance_model.reset(new QStandardItemModel());
-    for (size_t i = 0; i < nw::kernel::rules().appearances.entries.size(); ++i) {
-        const auto& app = nw::kernel::rules().appearances.entries[i];
-        if (!app.valid()) { continue; }
-        if (nw::string::icmp(app.model_type, "P")) {
-            auto item = new QStandardItem(to_qstring(app.editor_name()));
-            item->setData(int(i));
-            dynamic_appearance_model->appendRow(item);
-        }
-    }
-    dynamic_appearance_model->sort(-1);
-    dynamic_appearance_model->moveToThread(QCoreApplication::instance()->thread());
-
-    cloak_model.reset(new QStandardItemModel);
-    auto cloakmodel = nw::kernel::twodas().get("cloakmodel");
-    if (cloakmodel) {
-        std::string name;
-        for (size_t i = 0; i < cloakmodel->rows(); ++i) {
-            if (cloakmodel->get_to(i, "LABEL", name)) {
-                auto item = new QStandardItem(to_qstring(name));
-                item->setData(int(i));
-                cloak_model->appendRow(item);
-            }
-        }
-        cloak_model->sort(0);
-        cloak_model->moveToThread(QCoreApplication::instance()->thread());
-    }
-
-    auto create_part_model = [](const nw::StaticTwoDA* tda) {
-        auto result = new QStandardItemModel;
-        if (!tda) { return result; }
-        float temp;
-        size_t col = tda->column_index("ACBONUS");
-        if (col == nw::StaticTwoDA::npos) { return result; }
-
-        for (size_t i = 0; i < tda->rows(); ++i) {
-            if (tda->get_to(i, col, temp)) {
-                auto item = new QStandardItem(QString::number(i));
-                item->setData(int(i));
-                result->appendRow(item);
-            }
-        }
-        result->moveToThread(QCoreApplication::instance()->thread());
-        return result;
-    };
+}
 
-    parts_belt.reset(create_part_model(nw::kernel::twodas().get("parts_belt")));
-    parts_bicep.reset(create_part_model(nw::kernel::twodas().get("parts_bicep")));
-    parts_chest.reset(create_part_model(nw::kernel::twodas().get("parts_chest")));
-    parts_foot.reset(create_part_model(nw::kernel::twodas().get("parts_foot")));
-    parts_forearm.reset(create_part_model(nw::kernel::twodas().get("parts_forearm")));
-    parts_hand.reset(create_part_model(nw::kernel::twodas().get("parts_hand")));
-    parts_legs.reset(create_part_model(nw::kernel::twodas().get("parts_legs")));
-    parts_neck.reset(create_part_model(nw::kernel::twodas().get("parts_neck")));
-    parts_pelvis.reset(create_part_model(nw::kernel::twodas().get("parts_pelvis")));
-    parts_robe.reset(create_part_model(nw::kernel::twodas().get("parts_robe")));
-    parts_shin.reset(create_part_model(nw::kernel::twodas().get("parts_shin")));
-    parts_shoulder.reset(create_part_model(nw::kernel::twodas().get("parts_shoulder")));
+const std::vector<int>& ToolsetService::body_part_numbers(std::string_view part, char race, int phenotype, bool female) const
+{
+    return catalogue.body_parts(PartModelKey{nw::String{part}, race, phenotype, female});
 }
 
 CompositeModels ToolsetService::get_composite_models(std::string_view type, bool mdl)
 {
-    std::string search = fmt::format(R"({}_([tmb])_(\d{{3}})\.{})", type,
-        mdl ? "mdl" : "(dds|tga)");
-
-    std::regex pattern(search);
     auto it = composite_model_map.find(type);
     if (it != std::end(composite_model_map)) {
         return it->second;
     }
 
-    absl::btree_map<int, absl::btree_set<int>> top_colors_per_model, mid_colors_per_model, bot_colors_per_model;
-    absl::btree_map<int, absl::btree_set<int>> color_to_models_top, color_to_models_mid, color_to_models_bot;
-
-    absl::btree_set<int> top_models, mid_models, bot_models;
-    int count = 0;
-
-    auto filter = [&](const nw::Resource& res) {
-        std::string filename = res.filename();
-        std::smatch matches;
-        if (std::regex_match(filename, matches, pattern)) {
-            int value = std::stoi(matches[2].str());
-            char part = matches[1].str()[0];
-            int model_id = value / 10;
-            int color_id = value % 10;
-
-            if (model_id > 0 && color_id > 0) {
-                if (part == 't') {
-                    top_models.insert(model_id);
-                    top_colors_per_model[model_id].insert(color_id);
-                    color_to_models_top[color_id].insert(model_id);
-                } else if (part == 'm') {
-                    mid_models.insert(model_id);
-                    mid_colors_per_model[model_id].insert(color_id);
-                    color_to_models_mid[color_id].insert(model_id);
-                } else if (part == 'b') {
-                    bot_models.insert(model_id);
-                    bot_colors_per_model[model_id].insert(color_id);
-                    color_to_models_bot[color_id].insert(model_id);
+    absl::btree_map<int, absl::btree_set<int>> color_to_models[3];
+    absl::btree_set<int> part_models[3];
+
+    if (auto entry = catalogue.items(type, mdl)) {
+        for (size_t part = 0; part < 3; ++part) {
+            for (int value : entry->parts[part]) {
+                int model_id = value / 10;
+                int color_id = value % 10;
+                if (model_id > 0 && color_id > 0) {
+                    part_models[part].insert(model_id);
+                    color_to_models[part][color_id].insert(model_id);
                 }
             }
-            ++count;
         }
-    };
-
-    if (mdl) {
-        nw::kernel::resman().visit(filter, {nw::ResourceType::mdl});
-    } else {
-        nw::kernel::resman().visit(filter, {nw::ResourceType::dds, nw::ResourceType::tga});
     }
 
     auto create_model = [](const absl::btree_set<int>& set) -> QStandardItemModel* {
@@ -431,12 +486,12 @@ CompositeModels ToolsetService::get_composite_models(std::string_view type, bool
     };
 
     CompositeModels models;
-    models.top_model = create_model(top_models);
-    models.top_color = create_color_model(color_to_models_top);
-    models.middle_model = create_model(mid_models);
-    models.middle_color = create_color_model(color_to_models_mid);
-    models.bottom_model = create_model(bot_models);
-    models.bottom_color = create_color_model(color_to_models_bot);
+    models.top_model = create_model(part_models[0]);
+    models.top_color = create_color_model(color_to_models[0]);
+    models.middle_model = create_model(part_models[1]);
+    models.middle_color = create_color_model(color_to_models[1]);
+    models.bottom_model = create_model(part_models[2]);
+    models.bottom_color = create_color_model(color_to_models[2]);
 
     composite_model_map.insert({std::string(type), models});
 
@@ -445,26 +500,16 @@ CompositeModels ToolsetService::get_composite_models(std::string_view type, bool
 
 QStandardItemModel* ToolsetService::get_layered_models(std::string_view type)
 {
-    std::string search = fmt::format(R"({}_(\d{{3}})\.mdl)", type);
-    absl::btree_set<int> models;
-
-    std::regex pattern(search);
     auto it = simple_model_map.find(type);
     if (it != std::end(simple_model_map)) {
         return it->second.get();
     }
 
-    auto filter = [&](const nw::Resource& res) {
-        std::string filename = res.filename();
-        std::smatch matches;
-        if (std::regex_match(filename, matches, pattern)) {
-            int value = std::stoi(matches[1].str());
-            models.insert(value);
-        }
-    };
-    nw::kernel::resman().visit(filter, {nw::ResourceType::mdl});
+    static const std::vector<int> empty;
+    auto entry = catalogue.items(type, true);
+    const auto& models = entry ? entry->simple : empty;
 
-    auto create_model = [&](absl::btree_set<int>& set) -> QStandardItemModel* {
+    auto create_model = [&](const std::vector<int>& set) -> QStandardItemModel* {
         auto model = new QStandardItemModel;
         for (auto val : set) {
             auto resref = fmt::format("{}_{:03d}", type, val);
@@ -482,49 +527,21 @@ QStandardItemModel* ToolsetService::get_layered_models(std::string_view type)
 
 QStandardItemModel* ToolsetService::get_simple_models(std::string_view type)
 {
-    std::string search = fmt::format(R"({}_(\d{{3}})\.(dds|tga))", type);
-    absl::btree_set<int> models;
-
-    std::regex pattern(search);
     auto it = simple_model_map.find(type);
     if (it != std::end(simple_model_map)) {
         return it->second.get();
     }
 
-    auto filter = [&](const nw::Resource& res) {
-        std::string filename = res.filename();
-        std::smatch matches;
-        if (std::regex_match(filename, matches, pattern)) {
-            int value = std::stoi(matches[1].str());
-            models.insert(value);
-        }
-    };
+    static const std::vector<int> empty;
+    auto entry = catalogue.items(type, false);
+    const auto& models = entry ? entry->simple : empty;
 
-    nw::kernel::resman().visit(filter, {nw::ResourceType::dds, nw::ResourceType::tga});
-
-    auto create_model = [&](absl::btree_set<int>& set) -> QStandardItemModel* {
-        auto model = new QStandardItemModel;
+    auto create_model = [&](const std::vector<int>& set) -> QStandardItemModel* {
+        auto model = new LazyIconModel;
         for (auto val : set) {
             auto resref = fmt::format("{}_{:03d}", type, val);
             auto item = new QStandardItem(QString::fromStdString(resref));
-            auto rdata = nw::kernel::resman().demand_in_order(nw::Resref(resref),
-                {nw::ResourceType::dds, nw::ResourceType::tga});
-
-            if (rdata.bytes.size()) {
-                nw::Image icon{std::move(rdata)};
-                QImage image(icon.release(), icon.width(), icon.height(), icon.channels() == 4 ? QImage::Format_RGBA8888 : QImage::Format_RGB888,
-                    [](void* bytes) { if (bytes) { free(bytes); } });
-
-                // stb automatically flips standard dds and tga,
-                // so here for bioware dds which is implemented a bit differently
-                // needs to be flipped back to right side up.
-                if (icon.is_bio_dds()) {
-                    image.mirror();
-                }
-
-                item->setIcon(QIcon(QPixmap::fromImage(image)));
-            }
-
+            item->setData(QString::fromStdString(resref), LazyIconModel::ResrefRole);
             item->setData(val);
             model->appendRow(item);
         }
@@ -3,6 +3,7 @@
 
 #include "../../widgets/proxymodels.h"
 #include "../../widgets/statictwodamodel.h"
+#include "resourcecatalogue.h"
 #include "rulesetmodels.h"
 
 #include "nw/config.hpp"
@@ -26,17 +27,6 @@ struct CompositeModels {
     QStandardItemModel* bottom_color;
 };
 
-struct PartModels {
-    nw::String part;
-    char race = 'h';
-    int phenotype = 0;
-    bool female = false;
-    int number = 0;
-
-    auto operator<=>(const PartModels&) const noexcept = default;
-    bool operator==(const PartModels&) const noexcept = default;
-};
-
 struct ToolsetService : public nw::kernel::Service {
     const static std::type_index type_index;
 
@@ -49,7 +39,11 @@ struct ToolsetService : public nw::kernel::Service {
     QStandardItemModel* get_layered_models(std::string_view type);
     QStandardItemModel* get_simple_models(std::string_view type);
 
-    nw::Vector<PartModels> body_part_models;
+    /// Gets sorted part model numbers for a body part, race is the appearance's single character
+    /// model name, e.g. 'H'.
+    const std::vector<int>& body_part_numbers(std::string_view part, char race, int phenotype, bool female) const;
+
+    ResourceCatalogue catalogue;
 
     // All the below models should be considered lagically const,
     // once created they need to be moved on the main thread,
@@ -0,0 +1,156 @@
+#include "trace.h"
+
+#include <nw/log.hpp>
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QThread>
+
+#include <chrono>
+
+namespace {
+
+int64_t steady_us() noexcept
+{
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+std::string current_thread_name()
+{
+    auto thread = QThread::currentThread();
+    auto app = QCoreApplication::instance();
+    if (app && thread == app->thread()) { return "GUI"; }
+    auto name = thread ? thread->objectName() : QString{};
+    return name.isEmpty() ? std::string("worker") : name.toStdString();
+}
+
+} // namespace
+
+// == Tracer ==================================================================
+// ============================================================================
+
+Tracer::Tracer()
+    : epoch_{steady_us()}
+{
+}
+
+void Tracer::start(const QString& path)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    path_ = path;
+    events_.clear();
+    events_.reserve(4096);
+    enabled_.store(true, std::memory_order_relaxed);
+    LOG_F(INFO, "[trace] tracing to '{}'", path.toStdString());
+}
+
+bool Tracer::start_from(const QStringList& args)
+{
+    QString path;
+    for (qsizetype i = 0; i < args.size(); ++i) {
+        if (args[i] == "--trace" && i + 1 < args.size()) {
+            path = args[i + 1];
+            break;
+        } else if (args[i].startsWith("--trace=")) {
+            path = args[i].mid(8);
+            break;
+        }
+    }
+    if (path.isEmpty()) {
+        path = qEnvironmentVariable("ARCLIGHT_TRACE");
+    }
+    if (path.isEmpty()) { return false; }
+
+    start(path);
+    return true;
+}
+
+bool Tracer::stop()
+{
+    if (!enabled_.exchange(false)) { return false; }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto pid = QCoreApplication::applicationPid();
+
+    QJsonArray events;
+    events.append(QJsonObject{
+        {"name", "process_name"},
+        {"ph", "M"},
+        {"pid", pid},
+        {"args", QJsonObject{{"name", QCoreApplication::applicationName()}}},
+    });
+    for (const auto& [tid, name] : thread_names_) {
+        events.append(QJsonObject{
+            {"name", "thread_name"},
+            {"ph", "M"},
+            {"pid", pid},
+            {"tid", qint64(tid)},
+            {"args", QJsonObject{{"name", QString::fromStdString(name)}}},
+        });
+    }
+
+    for (const auto& event : events_) {
+        QJsonObject obj{
+            {"name", event.name},
+            {"cat", event.category},
+            {"ph", "X"},
+            {"ts", event.start_us},
+            {"dur", event.duration_us},
+            {"pid", pid},
+            {"tid", qint64(event.tid)},
+        };
+        if (!event.arg.empty()) {
+            obj.insert("args", QJsonObject{{"detail", QString::fromStdString(event.arg)}});
+        }
+        events.append(obj);
+    }
+
+    QFile file(path_);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        LOG_F(ERROR, "[trace] failed to open '{}'", path_.toStdString());
+        return false;
+    }
+    file.write(QJsonDocument(QJsonObject{
+                                 {"traceEvents", events},
+                                 {"displayTimeUnit", "ms"},
+                             })
+                   .toJson(QJsonDocument::Compact));
+
+    LOG_F(INFO, "[trace] wrote {} events to '{}'", events_.size(), path_.toStdString());
+    events_.clear();
+    return true;
+}
+
+int64_t Tracer::now_us() const noexcept
+{
+    return steady_us() - epoch_;
+}
+
+void Tracer::record(TraceEvent event)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!enabled()) { return; }
+    events_.push_back(std::move(event));
+}
+
+uint32_t Tracer::thread_id()
+{
+    thread_local uint32_t s_tid = 0;
+    if (s_tid == 0) {
+        auto name = current_thread_name();
+        std::lock_guard<std::mutex> lock(mutex_);
+        s_tid = next_tid_++;
+        thread_names_.emplace_back(s_tid, std::move(name));
+    }
+    return s_tid;
+}
+
+Tracer& tracer()
+{
+    static Tracer s_tracer;
+    return s_tracer;
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <QString>
+#include <QStringList>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// == Tracer ==================================================================
+// ============================================================================
+
+/// A completed span in Chrome's trace event format
+struct TraceEvent {
+    const char* name = nullptr;     ///< Must be a string literal or otherwise outlive the tracer
+    const char* category = nullptr; ///< Must be a string literal or otherwise outlive the tracer
+    std::string arg;                ///< Optional detail, e.g. a resource name
+    int64_t start_us = 0;
+    int64_t duration_us = 0;
+    uint32_t tid = 0;
+};
+
+/// Collects trace spans and writes them as Chrome/Perfetto JSON
+///
+/// Tracing is off unless started with ``--trace <file>`` or the ``ARCLIGHT_TRACE`` environment variable,
+/// when off a span costs little more than an atomic load.
+class Tracer {
+public:
+    Tracer();
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+    bool enabled() const noexcept { return enabled_.load(std::memory_order_relaxed); }
+
+    /// Starts tracing, events are written to ``path`` by ``stop``
+    void start(const QString& path);
+
+    /// Starts tracing if requested by ``args`` or the environment, returns true if tracing
+    bool start_from(const QStringList& args);
+
+    /// Stops tracing and writes the trace file, returns false if nothing could be written
+    bool stop();
+
+    /// Microseconds since the tracer was created
+    int64_t now_us() const noexcept;
+
+    void record(TraceEvent event);
+
+    /// Small sequential id of the calling thread, named in the trace on first use
+    uint32_t thread_id();
+
+private:
+    std::atomic<bool> enabled_{false};
+    QString path_;
+    int64_t epoch_ = 0;
+    std::mutex mutex_;
+    std::vector<TraceEvent> events_;
+    std::vector<std::pair<uint32_t, std::string>> thread_names_;
+    uint32_t next_tid_ = 1;
+};
+
+Tracer& tracer();
+
+// == TraceScope ==============================================================
+// ============================================================================
+
+/// Records a span from construction to destruction if tracing is enabled
+class TraceScope {
+public:
+    explicit TraceScope(const char* name, const char* category = "arclight") noexcept
+    {
+        if (tracer().enabled()) {
+            name_ = name;
+            category_ = category;
+            start_ = tracer().now_us();
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+    ~TraceScope()
+    {
+        if (name_) {
+            auto end = tracer().now_us();
+            tracer().record({name_, category_, std::move(arg_), start_, end - start_, tracer().thread_id()});
+        }
+    }
+
+    /// True if the span is being recorded
+    bool active() const noexcept { return name_ != nullptr; }
+
+    void set_arg(std::string arg) { arg_ = std::move(arg); }
+
+private:
+    const char* name_ = nullptr;
+    const char* category_ = nullptr;
+    std::string arg_;
+    int64_t start_ = 0;
+};
+
+#define ARCLIGHT_TRACE_CONCAT_(a, b) a##b
+#define ARCLIGHT_TRACE_CONCAT(a, b) ARCLIGHT_TRACE_CONCAT_(a, b)
+
+/// Traces the rest of the enclosing scope as ``name``
+#define TRACE_SCOPE(name) TraceScope ARCLIGHT_TRACE_CONCAT(trace_scope_, __LINE__){name}
+
+/// Traces the rest of the enclosing scope as ``name``, ``arg`` is only evaluated when tracing
+#define TRACE_SCOPE_ARG(name, arg)                                         \
+    TraceScope ARCLIGHT_TRACE_CONCAT(trace_scope_, __LINE__){name};        \
+    if (ARCLIGHT_TRACE_CONCAT(trace_scope_, __LINE__).active()) {          \
+        ARCLIGHT_TRACE_CONCAT(trace_scope_, __LINE__).set_arg(arg);        \
+    }
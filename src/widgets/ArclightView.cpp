@@ -2,9 +2,14 @@
 
 #include "arclighttab.h"
 
+#include "../services/trace/trace.h"
+
 #include "nw/log.hpp"
 
+#include <QFutureWatcher>
+#include <QTabWidget>
 #include <QUndoStack>
+#include <QVBoxLayout>
 
 ArclightView::ArclightView(QWidget* parent)
     : QWidget(parent)
@@ -17,6 +22,42 @@ void ArclightView::addTab(ArclightTab* tab)
     tabs_.append(tab);
 }
 
+void ArclightView::addLazyTab(QTabWidget* tabs, const QString& label, std::function<QWidget*()> factory)
+{
+    auto page = new QWidget(tabs);
+    auto layout = new QVBoxLayout(page);
+    layout->setContentsMargins(0, 0, 0, 0);
+
+    // Only one connection per tab widget
+    if (!tabs->property("arclight_lazy").toBool()) {
+        tabs->setProperty("arclight_lazy", true);
+        connect(tabs, &QTabWidget::currentChanged, this, [this, tabs](int index) {
+            buildLazyTab(tabs->widget(index));
+        });
+    }
+
+    connect(page, &QObject::destroyed, this, [this, page]() { lazy_tabs_.remove(page); });
+    lazy_tabs_.insert(page, std::move(factory));
+    tabs->addTab(page, label);
+
+    if (tabs->currentWidget() == page) {
+        buildLazyTab(page);
+    }
+}
+
+void ArclightView::buildLazyTab(QWidget* page)
+{
+    auto it = lazy_tabs_.find(page);
+    if (it == lazy_tabs_.end()) { return; }
+
+    TRACE_SCOPE_ARG("ArclightView::buildLazyTab", metaObject()->className());
+    auto factory = std::move(it.value());
+    lazy_tabs_.erase(it);
+    if (auto widget = factory()) {
+        page->layout()->addWidget(widget);
+    }
+}
+
 bool ArclightView::modified() const noexcept
 {
     return modified_;
@@ -27,6 +68,29 @@ bool ArclightView::readOnly() const noexcept
     return read_only_;
 }
 
+void ArclightView::saveAsync(const QString& path, SaveWriter writer, std::function<void(const SaveResult&)> done)
+{
+    auto watcher = new QFutureWatcher<SaveResult>(this);
+    connect(watcher, &QFutureWatcher<SaveResult>::finished, this, [this, watcher, path, done = std::move(done)]() {
+        --saves_in_flight_;
+        SaveResult result{path, false, "save was cancelled"};
+        if (watcher->future().resultCount()) {
+            result = watcher->result();
+        }
+        if (done) { done(result); }
+        emit saveFinished(result.ok, result.path);
+        watcher->deleteLater();
+    });
+
+    ++saves_in_flight_;
+    watcher->setFuture(save_pipeline().save(path, std::move(writer)));
+}
+
+bool ArclightView::saving() const noexcept
+{
+    return saves_in_flight_ > 0;
+}
+
 void ArclightView::onModificationChanged(bool modified)
 {
     Q_UNUSED(modified);
@@ -1,8 +1,14 @@
 #pragma once
 
+#include "util/savepipeline.h"
+
+#include <QHash>
 #include <QWidget>
 
+#include <functional>
+
 class ArclightTab;
+class QTabWidget;
 class QUndoStack;
 
 /// Arclight View is an abstraction for any widget that is placed in the main window tab.
@@ -16,21 +22,37 @@ public:
     /// Adds a sub-tab to for the view to track
     void addTab(ArclightTab* tab);
 
+    /// Adds a page to ``tabs`` whose widget is only built by ``factory`` the first time
+    /// the page is activated.
+    void addLazyTab(QTabWidget* tabs, const QString& label, std::function<QWidget*()> factory);
+
     /// Get is modified.
     bool modified() const noexcept;
 
     /// Is view read only
     bool readOnly() const noexcept;
 
+    /// Saves a snapshot to ``path`` on a worker thread, ``done`` is called on the GUI thread
+    /// when the save completes.
+    void saveAsync(const QString& path, SaveWriter writer, std::function<void(const SaveResult&)> done = {});
+
+    /// Is a save from this view in flight
+    bool saving() const noexcept;
+
 public slots:
     void onModificationChanged(bool modified);
 
 signals:
     void activateUndoStack(QUndoStack*);
     void modificationChanged(bool modified);
+    void saveFinished(bool ok, const QString& path);
 
 private:
+    void buildLazyTab(QWidget* page);
+
     QList<ArclightTab*> tabs_;
+    QHash<QWidget*, std::function<QWidget*()>> lazy_tabs_;
     bool read_only_ = false;
     bool modified_ = false;
+    int saves_in_flight_ = 0;
 };
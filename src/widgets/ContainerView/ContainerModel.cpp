@@ -2,6 +2,7 @@
 
 #include "../util/restypeicons.h"
 #include "../util/strings.h"
+#include "../../services/fileio/fileio.h"
 
 extern "C" {
 #include <fzy/match.h>
@@ -19,6 +20,7 @@ extern "C" {
 #include <QUrl>
 
 #include <algorithm>
+#include <fstream>
 
 namespace fs = std::filesystem;
 
@@ -66,45 +68,43 @@ ContainerModel::ContainerModel(nw::Container* container, QObject* parent)
     std::sort(std::begin(resources_), std::end(resources_), [](const auto& a, const auto& b) {
         return a.name.filename() < b.name.filename();
     });
+    reindex(0);
+
+    if (dynamic_cast<nw::Erf*>(container_)) {
+        fs::path path{container_->path()};
+        if (fs::exists(path)) {
+            sources_.push_back(path);
+            for (const auto& [res, ref] : read_erf_index(path, 0)) {
+                refs_.emplace(res, ref);
+            }
+        }
+    }
 }
 
 void ContainerModel::addFile(const nw::Resource& res, const fs::path& file)
 {
     if (auto e = dynamic_cast<nw::Erf*>(container_)) {
-        if (e->erase(res)) {
-            e->add(file);
-            auto it = std::find_if(std::begin(resources_), std::end(resources_), [&res](const auto& rd) {
-                return rd.name == res;
-            });
-            *it = e->stat(res);
-            int row = static_cast<int>(std::distance(std::begin(resources_), it));
-            emit dataChanged(index(row, 0), index(row, columnCount()));
-        } else {
-            beginInsertRows(QModelIndex(), rowCount(), rowCount());
-            e->add(file);
-            resources_.push_back(e->stat(res));
-            endInsertRows();
-        }
+        refs_.erase(res);
+        files_[res] = file;
+        e->erase(res);
+        e->add(file);
+        setRow(e->stat(res));
     }
 }
 
 void ContainerModel::addFile(const nw::Resource& res, const nw::ResourceData& data)
 {
-    if (auto e = dynamic_cast<nw::Erf*>(container_)) {
-        if (e->erase(res)) {
-            e->add(res, data.bytes);
-            auto it = std::find_if(std::begin(resources_), std::end(resources_), [&res](const auto& rd) {
-                return rd.name == res;
-            });
-            *it = e->stat(res);
-            int row = static_cast<int>(std::distance(std::begin(resources_), it));
-            emit dataChanged(index(row, 0), index(row, columnCount()));
-        } else {
-            beginInsertRows(QModelIndex(), rowCount(), rowCount());
-            e->add(res, data.bytes);
-            resources_.push_back(e->stat(res));
-            endInsertRows();
+    if (dynamic_cast<nw::Erf*>(container_)) {
+        // Staged to disk so that the writer can stream it like any other file.
+        auto path = container_->working_directory() / res.filename();
+        std::ofstream f{path, std::ios::binary};
+        f.write(reinterpret_cast<const char*>(data.bytes.data()), static_cast<std::streamsize>(data.bytes.size()));
+        f.close();
+        if (!f) {
+            LOG_F(ERROR, "[erf] failed to stage '{}'", res.filename());
+            return;
         }
+        addFile(res, path);
     }
 }
 
@@ -126,7 +126,7 @@ void ContainerModel::addFiles(const QStringList& files)
         }
         if (nw::ResourceType::check_category(nw::ResourceType::container, r.type)) {
             mergeFiles({f});
-        } else if (erf->contains(r)) {
+        } else if (findRow(r) >= 0) {
             bool yes = false;
             if (!yes_to_all) {
                 auto b = QMessageBox::question(nullptr, "Overwrite File",
@@ -167,23 +167,29 @@ void ContainerModel::mergeFiles(const QStringList& files)
         case nw::ResourceType::erf:
         case nw::ResourceType::hak:
         case nw::ResourceType::mod: {
-            nw::Erf e{p};
-            for (const auto& rd : e.all()) {
-                if (erf->contains(rd.name)) {
+            // Only the key and resource tables are read, data is copied from the source file on save.
+            auto source = static_cast<uint32_t>(sources_.size());
+            sources_.push_back(p);
+            for (const auto& [res, ref] : read_erf_index(p, source)) {
+                if (findRow(res) >= 0) {
                     bool yes = false;
                     if (!yes_to_all) {
                         auto b = QMessageBox::question(nullptr, "Overwrite File",
-                            to_qstring(fmt::format("'{}' already exists, would you like to overwrite?", rd.name.filename())),
+                            to_qstring(fmt::format("'{}' already exists, would you like to overwrite?", res.filename())),
                             QMessageBox::Yes | QMessageBox::No | QMessageBox::YesToAll);
                         yes_to_all = b == QMessageBox::YesToAll;
                         yes = b == QMessageBox::Yes;
                     }
-                    if (yes_to_all || yes) {
-                        addFile(rd.name, e.demand(rd.name));
-                    }
-                } else {
-                    addFile(rd.name, e.demand(rd.name));
+                    if (!yes_to_all && !yes) { continue; }
+                    erf->erase(res);
+                    files_.erase(res);
                 }
+
+                refs_[res] = ref;
+                nw::ResourceDescriptor rd;
+                rd.name = res;
+                rd.size = ref.size;
+                setRow(rd);
             }
         } break;
         }
@@ -195,6 +201,95 @@ void ContainerModel::setColumnCount(int cols)
     cols_ = cols;
 }
 
+int ContainerModel::findRow(const nw::Resource& res) const
+{
+    auto it = index_.find(res);
+    return it != index_.end() ? static_cast<int>(it->second) : -1;
+}
+
+std::vector<ErfWriteEntry> ContainerModel::writeEntries() const
+{
+    std::vector<ErfWriteEntry> result;
+    result.reserve(resources_.size());
+    for (const auto& rd : resources_) {
+        result.push_back(writeEntry(rd));
+    }
+
+    std::sort(std::begin(result), std::end(result), [](const auto& a, const auto& b) {
+        return a.name.filename() < b.name.filename();
+    });
+    return result;
+}
+
+std::vector<ErfWriteEntry> ContainerModel::writeEntries(const QModelIndexList& indexes) const
+{
+    std::vector<int> rows;
+    rows.reserve(static_cast<size_t>(indexes.size()));
+    for (const auto& idx : indexes) {
+        if (idx.isValid()) { rows.push_back(idx.row()); }
+    }
+    std::sort(std::begin(rows), std::end(rows));
+    rows.erase(std::unique(std::begin(rows), std::end(rows)), std::end(rows));
+
+    std::vector<ErfWriteEntry> result;
+    result.reserve(rows.size());
+    for (int row : rows) {
+        result.push_back(writeEntry(resources_[static_cast<size_t>(row)]));
+    }
+    return result;
+}
+
+ErfWriteEntry ContainerModel::writeEntry(const nw::ResourceDescriptor& rd) const
+{
+    ErfWriteEntry entry;
+    entry.name = rd.name;
+    if (auto it = refs_.find(rd.name); it != refs_.end()) {
+        entry.source = sources_[it->second.source];
+        entry.offset = it->second.offset;
+        entry.size = it->second.size;
+    } else {
+        // Extraction is left to ``extract_write_entries`` and sizing to ``resolve_write_entry``.
+        entry.whole_file = true;
+        auto fit = files_.find(rd.name);
+        if (fit != files_.end()) {
+            entry.source = fit->second;
+        } else {
+            entry.source = container_->working_directory() / rd.name.filename();
+            entry.extract_from = container_;
+        }
+    }
+    return entry;
+}
+
+void ContainerModel::forget(const nw::Resource& res)
+{
+    refs_.erase(res);
+    files_.erase(res);
+    index_.erase(res);
+}
+
+void ContainerModel::reindex(size_t from)
+{
+    for (size_t i = from; i < resources_.size(); ++i) {
+        index_[resources_[i].name] = i;
+    }
+}
+
+void ContainerModel::setRow(const nw::ResourceDescriptor& rd)
+{
+    auto it = index_.find(rd.name);
+    if (it != index_.end()) {
+        int row = static_cast<int>(it->second);
+        resources_[it->second] = rd;
+        emit dataChanged(index(row, 0), index(row, columnCount() - 1));
+    } else {
+        beginInsertRows(QModelIndex(), rowCount(), rowCount());
+        index_.emplace(rd.name, resources_.size());
+        resources_.push_back(rd);
+        endInsertRows();
+    }
+}
+
 bool ContainerModel::canDropMimeData(const QMimeData* mime, Qt::DropAction action, int row, int column, const QModelIndex& parent) const
 {
     Q_UNUSED(action);
@@ -299,7 +394,13 @@ QMimeData* ContainerModel::mimeData(const QModelIndexList& indexes) const
     for (const auto& idx : indexes) {
         size_t row = static_cast<size_t>(idx.row());
         auto name = resources_[row].name.filename();
-        container_->extract_by_glob(name, container_->working_directory());
+        auto it = refs_.find(resources_[row].name);
+        if (it != refs_.end()) {
+            const auto& ref = it->second;
+            copy_file_region(sources_[ref.source], ref.offset, ref.size, container_->working_directory() / name);
+        } else {
+            container_->extract_by_glob(name, container_->working_directory());
+        }
         auto fn = nw::path_to_string(container_->working_directory() / name);
         auto url = QUrl::fromLocalFile(to_qstring(fn));
         if (!urls.contains(url)) {
@@ -325,17 +426,78 @@ bool ContainerModel::removeRows(int row, int count, const QModelIndex& index)
 
     Q_UNUSED(index);
     beginRemoveRows(QModelIndex(), row, row + count - 1);
-    for (int i = 0; i < count; ++i) {
-        erf->erase(resources_[row].name);
-        resources_.erase(std::begin(resources_) + row);
+    for (int i = row; i < row + count; ++i) {
+        const auto& res = resources_[static_cast<size_t>(i)].name;
+        erf->erase(res);
+        forget(res);
     }
+    resources_.erase(std::begin(resources_) + row, std::begin(resources_) + row + count);
+    reindex(static_cast<size_t>(row));
     endRemoveRows();
     return true;
 }
 
+bool ContainerModel::removeIndexes(const QModelIndexList& indexes)
+{
+    nw::Erf* erf = nullptr;
+    if (!(erf = dynamic_cast<nw::Erf*>(container_))) {
+        return false;
+    }
+
+    std::vector<size_t> rows;
+    rows.reserve(static_cast<size_t>(indexes.size()));
+    for (const auto& idx : indexes) {
+        if (idx.isValid()) { rows.push_back(static_cast<size_t>(idx.row())); }
+    }
+    std::sort(std::begin(rows), std::end(rows));
+    rows.erase(std::unique(std::begin(rows), std::end(rows)), std::end(rows));
+    if (rows.empty()) { return true; }
+
+    for (auto row : rows) {
+        erf->erase(resources_[row].name);
+        forget(resources_[row].name);
+    }
+
+    std::vector<std::pair<size_t, size_t>> ranges;
+    for (auto row : rows) {
+        if (!ranges.empty() && ranges.back().second + 1 == row) {
+            ranges.back().second = row;
+        } else {
+            ranges.emplace_back(row, row);
+        }
+    }
+
+    // Each range shifts the tail of the vector, past a point a reset with a single compaction is cheaper.
+    constexpr size_t max_removal_ranges = 64;
+    if (ranges.size() > max_removal_ranges) {
+        beginResetModel();
+        size_t out = rows.front();
+        size_t next = 0;
+        for (size_t i = rows.front(); i < resources_.size(); ++i) {
+            if (next < rows.size() && rows[next] == i) {
+                ++next;
+                continue;
+            }
+            resources_[out++] = std::move(resources_[i]);
+        }
+        resources_.resize(out);
+        reindex(rows.front());
+        endResetModel();
+    } else {
+        // Last to first, so that earlier ranges keep their positions
+        for (auto it = ranges.rbegin(); it != ranges.rend(); ++it) {
+            beginRemoveRows(QModelIndex(), static_cast<int>(it->first), static_cast<int>(it->second));
+            resources_.erase(std::begin(resources_) + it->first, std::begin(resources_) + it->second + 1);
+            endRemoveRows();
+        }
+        reindex(rows.front());
+    }
+    return true;
+}
+
 int ContainerModel::rowCount(const QModelIndex& parent) const
 {
-    return !parent.isValid() ? static_cast<int>(container_->size()) : 0;
+    return !parent.isValid() ? static_cast<int>(resources_.size()) : 0;
 }
 
 Qt::DropActions ContainerModel::supportedDropActions() const
@@ -1,7 +1,12 @@
 #pragma once
 
+#include "ErfIndex.hpp"
+#include "ErfWriter.hpp"
+
 #include <nw/resources/Container.hpp>
 
+#include <absl/container/flat_hash_map.h>
+
 #include <QAbstractTableModel>
 #include <QDropEvent>
 #include <QSortFilterProxyModel>
@@ -38,6 +43,18 @@ public:
     void mergeFiles(const QStringList& files);
     void setColumnCount(int cols);
 
+    /// Removes the rows of ``indexes``, which must be indexes into this model, in as few batches as possible
+    bool removeIndexes(const QModelIndexList& indexes);
+
+    /// Gets the row of ``res``, -1 if not found
+    int findRow(const nw::Resource& res) const;
+
+    /// Gets every resource and the file region its data is read from, for ``ErfWriter``
+    std::vector<ErfWriteEntry> writeEntries() const;
+
+    /// Gets the resources at ``indexes``, which must be indexes into this model, once per row
+    std::vector<ErfWriteEntry> writeEntries(const QModelIndexList& indexes) const;
+
     // QAbstractTableModel overrides
     virtual bool canDropMimeData(const QMimeData* data, Qt::DropAction action, int row, int column, const QModelIndex& parent) const override;
     virtual int columnCount(const QModelIndex& parent = QModelIndex()) const override;
@@ -52,8 +69,20 @@ public:
     virtual Qt::DropActions supportedDropActions() const override;
 
 private:
+    void forget(const nw::Resource& res);
+    void reindex(size_t from);
+    void setRow(const nw::ResourceDescriptor& rd);
+    ErfWriteEntry writeEntry(const nw::ResourceDescriptor& rd) const;
+
     nw::Container* container_ = nullptr;
     std::vector<nw::ResourceDescriptor> resources_;
+    absl::flat_hash_map<nw::Resource, size_t> index_;
+
+    // Resources whose data is still in an ERF on disk, either the original file or a merged one,
+    // and resources added from loose files.
+    absl::flat_hash_map<nw::Resource, ErfEntryRef> refs_;
+    absl::flat_hash_map<nw::Resource, std::filesystem::path> files_;
+    std::vector<std::filesystem::path> sources_;
     QString path_;
     int cols_ = 1;
 };
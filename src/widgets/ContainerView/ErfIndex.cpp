@@ -0,0 +1,85 @@
+#include "ErfIndex.hpp"
+
+#include <nw/log.hpp>
+#include <nw/util/platform.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct ErfResEntry {
+    uint32_t offset;
+    uint32_t size;
+};
+
+} // namespace
+
+bool read_erf_header(const fs::path& path, ErfHeader& header)
+{
+    std::ifstream f{path, std::ios::binary};
+    return f && f.read(reinterpret_cast<char*>(&header), sizeof(ErfHeader));
+}
+
+std::vector<std::pair<nw::Resource, ErfEntryRef>> read_erf_index(const fs::path& path, uint32_t source)
+{
+    std::vector<std::pair<nw::Resource, ErfEntryRef>> result;
+
+    std::ifstream f{path, std::ios::binary};
+    if (!f) {
+        LOG_F(ERROR, "[erf] unable to open '{}'", nw::path_to_string(path));
+        return result;
+    }
+
+    ErfHeader header;
+    if (!f.read(reinterpret_cast<char*>(&header), sizeof(ErfHeader))) {
+        LOG_F(ERROR, "[erf] '{}' invalid header", nw::path_to_string(path));
+        return result;
+    }
+
+    size_t resref_size = 0;
+    if (std::memcmp(header.version, "V1.0", 4) == 0) {
+        resref_size = 16;
+    } else if (std::memcmp(header.version, "V1.1", 4) == 0) {
+        resref_size = 32;
+    } else {
+        LOG_F(ERROR, "[erf] '{}' unsupported version", nw::path_to_string(path));
+        return result;
+    }
+
+    // Key: resref, resource id (uint32), type (uint16), unused (uint16)
+    const size_t key_size = resref_size + 8;
+    std::vector<char> keys(key_size * header.entry_count);
+    std::vector<ErfResEntry> entries(header.entry_count);
+
+    f.seekg(header.offset_keys);
+    f.read(keys.data(), static_cast<std::streamsize>(keys.size()));
+    f.seekg(header.offset_res);
+    f.read(reinterpret_cast<char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(ErfResEntry)));
+    if (!f) {
+        LOG_F(ERROR, "[erf] '{}' truncated key or resource table", nw::path_to_string(path));
+        return result;
+    }
+
+    result.reserve(header.entry_count);
+    for (uint32_t i = 0; i < header.entry_count; ++i) {
+        const char* key = keys.data() + i * key_size;
+        uint16_t type;
+        std::memcpy(&type, key + resref_size + 4, sizeof(uint16_t));
+
+        std::string resref{key, ::strnlen(key, resref_size)};
+        std::transform(resref.begin(), resref.end(), resref.begin(), [](unsigned char c) {
+            return static_cast<char>(std::tolower(c));
+        });
+
+        nw::Resource res{resref, static_cast<nw::ResourceType::type>(type)};
+        if (!res.valid()) { continue; }
+        result.emplace_back(res, ErfEntryRef{source, entries[i].offset, entries[i].size});
+    }
+
+    return result;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <nw/resources/Resource.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <utility>
+#include <vector>
+
+/// On disk ERF header
+struct ErfHeader {
+    char type[4];
+    char version[4];
+    uint32_t locstring_count;
+    uint32_t locstring_size;
+    uint32_t entry_count;
+    uint32_t offset_locstring;
+    uint32_t offset_keys;
+    uint32_t offset_res;
+    uint32_t build_year;
+    uint32_t build_day;
+    uint32_t description_strref;
+    uint8_t reserved[116];
+};
+
+static_assert(sizeof(ErfHeader) == 160, "ERF header must be 160 bytes");
+
+/// Location of a resource's bytes inside an ERF on disk
+struct ErfEntryRef {
+    uint32_t source = 0; ///< Index into the owner's list of source files
+    uint32_t offset = 0;
+    uint32_t size = 0;
+};
+
+/// Reads the header of an ERF
+bool read_erf_header(const std::filesystem::path& path, ErfHeader& header);
+
+/// Reads the key and resource tables of an ERF without touching resource data.
+/// ``ErfEntryRef::source`` is set to ``source``.
+std::vector<std::pair<nw::Resource, ErfEntryRef>> read_erf_index(const std::filesystem::path& path, uint32_t source);
+
@@ -0,0 +1,212 @@
+#include "ErfWriter.hpp"
+
+#include "ErfIndex.hpp"
+#include "../../services/fileio/fileio.h"
+
+#include <nw/log.hpp>
+#include <nw/util/platform.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <string_view>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// Large resources are copied in chunks so progress and cancellation stay responsive.
+constexpr uint64_t copy_chunk_size = 8 * 1024 * 1024;
+
+struct ErfResEntry {
+    uint32_t offset;
+    uint32_t size;
+};
+
+void erf_type_from_extension(const fs::path& path, char (&type)[4])
+{
+    auto ext = nw::path_to_string(path.extension());
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (ext == ".hak") {
+        std::memcpy(type, "HAK ", 4);
+    } else if (ext == ".mod" || ext == ".nwm" || ext == ".sav") {
+        std::memcpy(type, "MOD ", 4);
+    } else {
+        std::memcpy(type, "ERF ", 4);
+    }
+}
+
+// Resref part of a resource's file name, resrefs are stored without the extension.
+std::string_view resref_of(const std::string& filename)
+{
+    return std::string_view{filename}.substr(0, filename.find('.'));
+}
+
+} // namespace
+
+void extract_write_entries(std::vector<ErfWriteEntry>& entries)
+{
+    for (auto& entry : entries) {
+        if (!entry.extract_from) { continue; }
+        entry.extract_from->extract_by_glob(entry.name.filename(), entry.source.parent_path());
+        entry.extract_from = nullptr;
+    }
+}
+
+bool resolve_write_entry(ErfWriteEntry& entry, std::string& error)
+{
+    if (entry.whole_file) {
+        std::error_code ec;
+        entry.size = fs::file_size(entry.source, ec);
+        if (ec) {
+            error = "unable to read '" + entry.name.filename() + "': " + ec.message();
+            return false;
+        }
+        entry.offset = 0;
+    }
+    return true;
+}
+
+bool ErfWriter::write(const fs::path& path, const ErfWriteProgress& progress)
+{
+    error.clear();
+
+    for (auto& e : entries) {
+        if (!resolve_write_entry(e, error)) { return false; }
+    }
+
+    ErfHeader header;
+    std::memset(&header, 0, sizeof(ErfHeader));
+
+    // Type, version and localized description are carried over verbatim from the original file.
+    std::vector<char> locstrings;
+    ErfHeader original;
+    bool v11 = false;
+    if (!locstrings_from.empty() && read_erf_header(locstrings_from, original)) {
+        std::memcpy(header.type, original.type, 4);
+        v11 = std::memcmp(original.version, "V1.1", 4) == 0;
+        header.locstring_count = original.locstring_count;
+        header.description_strref = original.description_strref;
+
+        locstrings.resize(original.locstring_size);
+        std::ifstream f{locstrings_from, std::ios::binary};
+        f.seekg(original.offset_locstring);
+        if (!f.read(locstrings.data(), static_cast<std::streamsize>(locstrings.size()))) {
+            header.locstring_count = 0;
+            locstrings.clear();
+        }
+    } else {
+        erf_type_from_extension(path, header.type);
+    }
+
+    for (const auto& e : entries) {
+        auto fn = e.name.filename();
+        auto resref = resref_of(fn);
+        if (resref.size() > 32) {
+            error = "resref '" + std::string{resref} + "' exceeds 32 characters";
+            return false;
+        }
+        v11 = v11 || resref.size() > 16;
+    }
+    std::memcpy(header.version, v11 ? "V1.1" : "V1.0", 4);
+
+    auto now = std::time(nullptr);
+    auto tm = *std::localtime(&now);
+    header.build_year = static_cast<uint32_t>(tm.tm_year);
+    header.build_day = static_cast<uint32_t>(tm.tm_yday);
+
+    // Key: resref, resource id (uint32), type (uint16), unused (uint16)
+    const size_t resref_size = v11 ? 32 : 16;
+    const size_t key_size = resref_size + 8;
+
+    header.entry_count = static_cast<uint32_t>(entries.size());
+    header.locstring_size = static_cast<uint32_t>(locstrings.size());
+    header.offset_locstring = sizeof(ErfHeader);
+    header.offset_keys = header.offset_locstring + header.locstring_size;
+    header.offset_res = header.offset_keys + header.entry_count * static_cast<uint32_t>(key_size);
+
+    std::vector<char> keys(entries.size() * key_size, 0);
+    std::vector<ErfResEntry> res_entries(entries.size());
+
+    uint64_t offset = uint64_t(header.offset_res) + entries.size() * sizeof(ErfResEntry);
+    uint64_t total = 0;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const auto& e = entries[i];
+        auto fn = e.name.filename();
+        auto resref = resref_of(fn);
+        auto id = static_cast<uint32_t>(i);
+        auto type = static_cast<uint16_t>(e.name.type);
+
+        char* key = keys.data() + i * key_size;
+        std::memcpy(key, resref.data(), resref.size());
+        std::memcpy(key + resref_size, &id, sizeof(uint32_t));
+        std::memcpy(key + resref_size + 4, &type, sizeof(uint16_t));
+
+        res_entries[i].offset = static_cast<uint32_t>(offset);
+        res_entries[i].size = static_cast<uint32_t>(e.size);
+        offset += e.size;
+        total += e.size;
+    }
+
+    if (offset > std::numeric_limits<uint32_t>::max()) {
+        error = "archive exceeds 4GB limit";
+        return false;
+    }
+
+    FileWriter out{path};
+    if (!out.ok()) {
+        error = "unable to open file for writing";
+        return false;
+    }
+
+    bool ok = out.write(&header, sizeof(ErfHeader))
+        && out.write(locstrings.data(), locstrings.size())
+        && out.write(keys.data(), keys.size())
+        && out.write(res_entries.data(), res_entries.size() * sizeof(ErfResEntry));
+    if (!ok) {
+        error = "failed to write header";
+        return false;
+    }
+
+    // Entries are generally grouped by source, keep the last one open.
+    std::unique_ptr<FileReader> in;
+    fs::path in_path;
+    uint64_t written = 0;
+
+    for (const auto& e : entries) {
+        if (!in || in_path != e.source) {
+            in = std::make_unique<FileReader>(e.source);
+            in_path = e.source;
+            if (!in->ok()) {
+                error = "unable to open '" + nw::path_to_string(e.source) + "'";
+                return false;
+            }
+        }
+
+        for (uint64_t done = 0; done < e.size;) {
+            auto chunk = std::min(copy_chunk_size, e.size - done);
+            if (!out.copy_from(*in, e.offset + done, chunk)) {
+                error = "failed to copy '" + e.name.filename() + "'";
+                return false;
+            }
+            done += chunk;
+            written += chunk;
+            if (progress && !progress(written, total)) {
+                error = "cancelled";
+                return false;
+            }
+        }
+    }
+
+    if (!out.close()) {
+        error = "failed to close file";
+        return false;
+    }
+
+    LOG_F(INFO, "[erf] wrote {} resources ({} bytes) to '{}'", entries.size(), total, nw::path_to_string(path));
+    return true;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <nw/resources/Container.hpp>
+#include <nw/resources/Resource.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+/// A resource to be written and the file region its bytes are copied from
+struct ErfWriteEntry {
+    nw::Resource name;
+    std::filesystem::path source;
+    uint64_t offset = 0;
+    uint64_t size = 0;
+    bool whole_file = false;               ///< ``source`` is all of the resource, ``size`` is read when resolved
+    nw::Container* extract_from = nullptr; ///< Container ``name`` is extracted from to ``source``, optional
+};
+
+/// Extracts entries that are only in their container, on the thread that owns the containers.
+///
+/// Containers aren't thread-safe and may be closed while a worker runs, so this has to happen before
+/// entries are handed to one.  ``extract_from`` is cleared.
+void extract_write_entries(std::vector<ErfWriteEntry>& entries);
+
+/// Sizes an entry, safe off the GUI thread once entries are extracted.  Returns false and sets ``error`` on failure.
+bool resolve_write_entry(ErfWriteEntry& entry, std::string& error);
+
+/// Called with bytes written and total bytes, return false to cancel
+using ErfWriteProgress = std::function<bool(uint64_t written, uint64_t total)>;
+
+/// Streams an ERF to disk.
+///
+/// Header, key list and resource table are written up front, resource data is then
+/// copied straight from each entry's source region, nothing is held in memory.
+/// V1.1 is written if the original was V1.1 or a resref doesn't fit in V1.0's 16 characters.
+/// Entries must already be extracted, see ``extract_write_entries``.
+struct ErfWriter {
+    std::vector<ErfWriteEntry> entries;
+    std::filesystem::path locstrings_from; ///< ERF to copy type, version and localized description from, optional
+    std::string error;
+
+    /// Writes to ``path``, returns false if an error occurred or the write was cancelled.
+    bool write(const std::filesystem::path& path, const ErfWriteProgress& progress = {});
+};
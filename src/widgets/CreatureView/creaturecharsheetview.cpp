@@ -181,6 +181,7 @@ void CreatureCharSheetView::onReloadStats()
 
 void CreatureCharSheetView::loadStatsAbilities()
 {
+    ui->stats->beginUpdate();
 
 #define ADD_INT_STAT(name, value, grp)                             \
     do {                                                           \
@@ -217,6 +218,7 @@ void CreatureCharSheetView::loadStatsAbilities()
         return lhs->name < rhs->name;
     });
     ui->stats->addProperty(grp_skills);
+    ui->stats->endUpdate();
 
 #undef ADD_INT_STAT
 }
@@ -9,9 +9,12 @@
 #include <QStandardItemModel>
 #include <QStringListModel>
 
-QSet<int> getPartModelNumbers(std::string_view name, nw::Appearance appearance, nw::Phenotype phenotype, bool feminine)
+#include <algorithm>
+#include <iterator>
+
+QList<int> getPartModelNumbers(std::string_view name, nw::Appearance appearance, nw::Phenotype phenotype, bool feminine)
 {
-    QSet<int> result;
+    QList<int> result;
 
     auto& tool = toolset();
     auto app = nw::kernel::rules().appearances.get(appearance);
@@ -24,22 +27,23 @@ QSet<int> getPartModelNumbers(std::string_view name, nw::Appearance appearance,
         LOG_F(ERROR, "Invalid phenotype");
         return result;
     }
+    if (app->model_name.size() != 1) { return result; }
+
+    // Male parts are available to both genders, female parts only to female creatures.
+    auto merge = [&](int pheno_id, bool female) {
+        const auto& numbers = tool.body_part_numbers(name, app->model_name[0], pheno_id, female);
+        if (numbers.empty()) { return; }
+        QList<int> merged;
+        merged.reserve(result.size() + qsizetype(numbers.size()));
+        std::set_union(result.begin(), result.end(), numbers.begin(), numbers.end(), std::back_inserter(merged));
+        result = std::move(merged);
+    };
 
-    for (auto& part : tool.body_part_models) {
-        if (part.part != name) { continue; }
-
-        if (app->model_name.size() != 1 || app->model_name[0] != part.race) {
-            continue;
-        }
-
-        if (*phenotype != part.phenotype && pheno->fallback != part.phenotype) {
-            continue;
-        } else if (part.female && !feminine) {
-            continue;
-        }
-
-        if (result.contains(part.number)) { continue; }
-        result.insert(part.number);
+    merge(*phenotype, false);
+    if (feminine) { merge(*phenotype, true); }
+    if (pheno->fallback != *phenotype) {
+        merge(pheno->fallback, false);
+        if (feminine) { merge(pheno->fallback, true); }
     }
     return result;
 }
@@ -74,12 +78,9 @@ void CreaturePartsView::loadProperties()
     addProperty(p);
 
     auto load_part = [this](QString name, std::string_view part, uint16_t* current, Property* parent) {
-        auto set = getPartModelNumbers(part, obj_->appearance.id, obj_->appearance.phenotype,
+        auto sorted = getPartModelNumbers(part, obj_->appearance.id, obj_->appearance.phenotype,
             obj_->gender == 1);
 
-        QList<int> sorted = set.values();
-        std::sort(sorted.begin(), sorted.end());
-
         QStringList values;
         int selected = -1;
         int i = 0;
@@ -233,6 +233,7 @@ void CreaturePropertiesView::loadAdvanced()
 
 void CreaturePropertiesView::loadProperties()
 {
+    beginUpdate();
     loadBasic();
     loadAbilities();
     loadSaves();
@@ -240,4 +241,5 @@ void CreaturePropertiesView::loadProperties()
     loadSkills();
     loadInterface();
     loadAdvanced();
+    endUpdate();
 }
@@ -168,20 +168,60 @@ void ModifySpellCommand::redo()
 }
 
 ClearSpellsCommand::ClearSpellsCommand(CreatureSpellSelector* selector, CreatureSpellModel* model,
-    nw::Creature* creature, nw::Class cls, int spellLevel, nw::SpellBook previous, nw::SpellBook next,
-    QUndoCommand* parent)
-    : QUndoCommand(parent)
+    nw::Creature* creature, nw::Class cls, int spellLevel, nw::SpellBook previous, bool memorizes,
+    int clearLevel, QUndoCommand* parent)
+    : HistoryCommand(parent)
     , selector_(selector)
     , model_(model)
     , creature_(creature)
     , class_(cls)
     , spell_level_(spellLevel)
-    , previous_{previous}
-    , next_{next}
+    , previous_{std::move(previous)}
+    , memorizes_{memorizes}
+    , clear_level_{clearLevel}
 {
     setText(QString("Clear Spells"));
 }
 
+void ClearSpellsCommand::clearSpells(nw::SpellBook& book, bool memorizes, int level)
+{
+    int i = 0;
+    if (memorizes) {
+        for (auto& it : book.memorized_) {
+            if (level == -1 || level == i) {
+                for (auto& entry : it) {
+                    entry = nw::SpellEntry{};
+                }
+            }
+            ++i;
+        }
+    } else {
+        for (auto& it : book.known_) {
+            if (level == -1 || level == i) {
+                it.clear();
+            }
+            ++i;
+        }
+    }
+}
+
+qsizetype ClearSpellsCommand::cost() const
+{
+    qsizetype result = HistoryCommand::cost();
+    for (const auto& it : previous_.memorized_) {
+        result += qsizetype(it.size() * sizeof(*it.begin()));
+    }
+    for (const auto& it : previous_.known_) {
+        result += qsizetype(it.size() * sizeof(*it.begin()));
+    }
+    return result;
+}
+
+void ClearSpellsCommand::release()
+{
+    previous_ = {};
+}
+
 void ClearSpellsCommand::notifyModelRangeChanged()
 {
     QModelIndex topLeft = model_->index(0, 2);
@@ -191,6 +231,7 @@ void ClearSpellsCommand::notifyModelRangeChanged()
 
 void ClearSpellsCommand::undo()
 {
+    if (!restore()) { return; }
     selector_->setClass(class_);
     selector_->setSpellFilterLevel(spell_level_);
     auto spellbook = creature_->levels.spells(class_);
@@ -201,12 +242,14 @@ void ClearSpellsCommand::undo()
 
 void ClearSpellsCommand::redo()
 {
+    if (!restore()) { return; }
     selector_->setClass(class_);
     selector_->setSpellFilterLevel(spell_level_);
 
     auto spellbook = creature_->levels.spells(class_);
     if (!spellbook) return;
-    *spellbook = next_;
+    *spellbook = previous_;
+    clearSpells(*spellbook, memorizes_, clear_level_);
     notifyModelRangeChanged();
 }
 
@@ -658,31 +701,10 @@ void CreatureSpellSelector::onClearClicked()
 
     auto spellbook = creature_->levels.spells(class_);
     auto spell_level = ui->level->currentIndex() - 1;
-    auto previous = *spellbook;
-    auto next = *spellbook;
-
-    int i = 0;
-    if (cls->memorizes_spells) {
-        for (auto& it : next.memorized_) {
-            if (spell_level == -1 || spell_level == i) {
-                for (auto& entry : it) {
-                    entry = nw::SpellEntry{};
-                }
-            }
-            ++i;
-        }
-    } else {
-        for (auto& it : next.known_) {
-            if (spell_level == -1 || spell_level == i) {
-                it.clear();
-            }
-            ++i;
-        }
-    }
 
     undoStack()->push(new ClearSpellsCommand(
         this, model_, creature_, class_,
-        ui->level->currentIndex(), previous, next));
+        ui->level->currentIndex(), *spellbook, cls->memorizes_spells, spell_level));
 }
 
 void CreatureSpellSelector::onFilterChanged(const QString& text)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../arclighttab.h"
+#include "../util/undohistory.h"
 
 #include "nw/objects/SpellBook.hpp"
 #include "nw/rules/Class.hpp"
@@ -54,14 +55,23 @@ private:
     int row_;
 };
 
-class ClearSpellsCommand : public QUndoCommand {
+class ClearSpellsCommand : public HistoryCommand {
 public:
+    /// ``clearLevel`` is the spell level to clear, or -1 for all levels
     ClearSpellsCommand(CreatureSpellSelector* selector, CreatureSpellModel* model, nw::Creature* creature,
-        nw::Class cls, int spellLevel, nw::SpellBook previous, nw::SpellBook next, QUndoCommand* parent = nullptr);
+        nw::Class cls, int spellLevel, nw::SpellBook previous, bool memorizes, int clearLevel,
+        QUndoCommand* parent = nullptr);
 
+    /// Clears ``level`` of ``book``, or every level if -1
+    static void clearSpells(nw::SpellBook& book, bool memorizes, int level);
+
+    qsizetype cost() const override;
     void undo() override;
     void redo() override;
 
+protected:
+    void release() override;
+
 private:
     struct SpellState {
         nw::Spell spell;
@@ -76,8 +86,9 @@ private:
     nw::Creature* creature_;
     nw::Class class_;
     int spell_level_;
-    nw::SpellBook previous_;
-    nw::SpellBook next_;
+    nw::SpellBook previous_; ///< The cleared book is rebuilt from this on redo
+    bool memorizes_;
+    int clear_level_;
 };
 
 // == CreatureSpellModel ======================================================
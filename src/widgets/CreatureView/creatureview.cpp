@@ -3,6 +3,7 @@
 
 #include "../VariableTableView/variabletableview.h"
 #include "../strreftextedit.h"
+#include "../util/objects.h"
 #include "../util/strings.h"
 
 #include "creatureabilitiesselector.h"
@@ -25,7 +26,7 @@
 #include <QTextEdit>
 
 CreatureView::CreatureView(nw::Resource res, QWidget* parent)
-    : CreatureView(nw::kernel::objects().load<nw::Creature>(res.resref), parent)
+    : CreatureView(load_object<nw::Creature>(res), parent)
 {
     owned_ = true;
 }
@@ -46,50 +47,69 @@ CreatureView::CreatureView(nw::Creature* obj, QWidget* parent)
     ui->tabWidget->addTab(charsheet, "Sheet");
     addTab(charsheet);
 
-    auto props = new CreaturePropertiesTab(obj, this);
-    props->setEnabled(!readOnly());
-    ui->tabWidget->addTab(props, "Properties");
-    addTab(props);
-    connect(props->properties(), &CreaturePropertiesView::reloadStats, charsheet, &CreatureCharSheetView::onReloadStats);
-
-    auto appearance = new CreatureAppearanceView(obj, this);
-    appearance->setEnabled(!readOnly());
-    ui->tabWidget->addTab(appearance, "Appearance");
-    addTab(appearance);
-    connect(appearance, &CreatureAppearanceView::updateModel, this, &CreatureView::onUpdateModel);
-
-    auto inv = new CreatureInventoryPanel(this);
-    inv->setEnabled(!readOnly());
-    inv->setCreature(obj);
-    ui->tabWidget->addTab(inv, "Inventory");
-    addTab(inv);
-
-    auto feats = new CreatureFeatSelector(obj, this);
-    ui->tabWidget->addTab(feats, "Feats");
-    addTab(feats);
-    connect(feats->model(), &CreatureFeatSelectorModel::featsChanged, charsheet, &CreatureCharSheetView::onReloadStats);
-
-    auto spells = new CreatureSpellSelector(obj, this);
-    ui->tabWidget->addTab(spells, "Spells");
-    addTab(spells);
-
-    auto abilities = new CreatureAbilitiesSelector(obj, this);
-    ui->tabWidget->addTab(abilities, "Special Abilities");
-    addTab(abilities);
-
-    auto variables = new VariableTableView(this);
-    variables->setEnabled(!readOnly());
-    variables->setLocals(&obj->common.locals);
-    ui->tabWidget->addTab(variables, tr("Variables"));
-    addTab(variables);
-
-    auto description = new StrrefTextEdit(this);
-    description->setLocstring(obj->description);
-    ui->tabWidget->addTab(description, "Description");
-
-    auto comments = new QTextEdit(this);
-    comments->setText(to_qstring(obj->common.comment));
-    ui->tabWidget->addTab(comments, "Comments");
+    // Remaining tabs are built the first time they're shown.
+    addLazyTab(ui->tabWidget, "Properties", [this, obj, charsheet]() {
+        auto props = new CreaturePropertiesTab(obj, this);
+        props->setEnabled(!readOnly());
+        addTab(props);
+        connect(props->properties(), &CreaturePropertiesView::reloadStats, charsheet, &CreatureCharSheetView::onReloadStats);
+        return props;
+    });
+
+    addLazyTab(ui->tabWidget, "Appearance", [this, obj]() {
+        auto appearance = new CreatureAppearanceView(obj, this);
+        appearance->setEnabled(!readOnly());
+        addTab(appearance);
+        connect(appearance, &CreatureAppearanceView::updateModel, this, &CreatureView::onUpdateModel);
+        return appearance;
+    });
+
+    addLazyTab(ui->tabWidget, "Inventory", [this, obj]() {
+        auto inv = new CreatureInventoryPanel(this);
+        inv->setEnabled(!readOnly());
+        inv->setCreature(obj);
+        addTab(inv);
+        return inv;
+    });
+
+    addLazyTab(ui->tabWidget, "Feats", [this, obj, charsheet]() {
+        auto feats = new CreatureFeatSelector(obj, this);
+        addTab(feats);
+        connect(feats->model(), &CreatureFeatSelectorModel::featsChanged, charsheet, &CreatureCharSheetView::onReloadStats);
+        return feats;
+    });
+
+    addLazyTab(ui->tabWidget, "Spells", [this, obj]() {
+        auto spells = new CreatureSpellSelector(obj, this);
+        addTab(spells);
+        return spells;
+    });
+
+    addLazyTab(ui->tabWidget, "Special Abilities", [this, obj]() {
+        auto abilities = new CreatureAbilitiesSelector(obj, this);
+        addTab(abilities);
+        return abilities;
+    });
+
+    addLazyTab(ui->tabWidget, tr("Variables"), [this, obj]() {
+        auto variables = new VariableTableView(this);
+        variables->setEnabled(!readOnly());
+        variables->setLocals(&obj->common.locals);
+        addTab(variables);
+        return variables;
+    });
+
+    addLazyTab(ui->tabWidget, "Description", [this, obj]() {
+        auto description = new StrrefTextEdit(this);
+        description->setLocstring(obj->description);
+        return description;
+    });
+
+    addLazyTab(ui->tabWidget, "Comments", [this, obj]() {
+        auto comments = new QTextEdit(this);
+        comments->setText(to_qstring(obj->common.comment));
+        return comments;
+    });
 
     obj_ = obj;
     onUpdateModel();
@@ -105,26 +125,29 @@ CreatureView::~CreatureView()
 
 void CreatureView::onUpdateModel()
 {
-    auto appearances_2da = nw::kernel::twodas().get("appearance");
-    std::string model_name;
-    // [TODO] Can't do parts based models yet..
-    if (!appearances_2da->get_to(*obj_->appearance.id, "RACE", model_name) || model_name.length() <= 1) {
-        LOG_F(INFO, "Can't render model.");
-    } else {
+    // Loading is deferred until the viewport is actually visible.
+    ui->openGLWidget->setModelLoader([obj = obj_]() -> std::unique_ptr<Model> {
+        auto appearances_2da = nw::kernel::twodas().get("appearance");
+        std::string model_name;
+        // [TODO] Can't do parts based models yet..
+        if (!appearances_2da->get_to(*obj->appearance.id, "RACE", model_name) || model_name.length() <= 1) {
+            LOG_F(INFO, "Can't render model.");
+            return nullptr;
+        }
+
         nw::Resref resref{model_name};
 
         LOG_F(INFO, "Loading model: {}", resref.view());
         auto model = load_model(resref.view());
         if (!model) {
             LOG_F(ERROR, "Failed to load model: {}", resref.view());
-            return;
+            return nullptr;
         }
 
         if (!model->load_animation("pause1")) {
             model->load_animation("cpause1");
         }
         LOG_F(INFO, "Model loaded: {}, nodes={}", resref.view(), model->nodes_.size());
-        ui->openGLWidget->setModel(std::move(model));
-        LOG_F(INFO, "Model set on RenderWidget");
-    }
+        return model;
+    });
 }
@@ -245,8 +245,33 @@ void DialogView::setModel(DialogModel* model)
     connect(ui->dialogView->selectionModel(), &QItemSelectionModel::selectionChanged, this, &DialogView::onSelectionChanged);
 }
 
+SaveWriter DialogView::makeSaveWriter() const
+{
+    QFileInfo fileInfo(path_);
+    auto ext = fileInfo.completeSuffix();
+    if (0 == ext.compare("dlg", Qt::CaseInsensitive)) {
+        // Builder owns a full copy of the dialog's data, the worker only builds and writes it.
+        auto oa = std::make_shared<nw::GffBuilder>(nw::serialize(model_->dialog()));
+        return [oa](const std::filesystem::path& temp) {
+            oa->write_to(temp);
+            return std::filesystem::exists(temp);
+        };
+    } else if (0 == ext.compare("dlg.json", Qt::CaseInsensitive)) {
+        auto j = std::make_shared<nlohmann::json>();
+        nw::serialize(*j, *model_->dialog());
+        return [j](const std::filesystem::path& temp) {
+            std::ofstream f{temp};
+            f << std::setw(4) << *j;
+            f.flush();
+            return f.good();
+        };
+    }
+    return {};
+}
+
 void DialogView::setModified(bool modified)
 {
+    if (modified) { ++generation_; }
     modified_ = modified;
     emit dataChanged(modified);
 }
@@ -786,19 +811,15 @@ void DialogView::onDialogPasteLinkNode()
 
 void DialogView::onDialogSave()
 {
-    QFileInfo fileInfo(path_);
-    auto ext = fileInfo.completeSuffix();
-    if (0 == ext.compare("dlg", Qt::CaseInsensitive)) {
-        nw::GffBuilder oa = nw::serialize(model_->dialog());
-        oa.write_to(path_.toStdString());
-        setModified(false);
-    } else if (0 == ext.compare("dlg.json", Qt::CaseInsensitive)) {
-        nlohmann::json j;
-        nw::serialize(j, *model_->dialog());
-        std::ofstream f{path_.toStdString()};
-        f << std::setw(4) << j;
-        setModified(false);
-    }
+    auto writer = makeSaveWriter();
+    if (!writer) { return; }
+
+    saveAsync(path_, std::move(writer), [this, generation = generation_](const SaveResult& result) {
+        // Only mark clean if nothing was edited after the snapshot was taken.
+        if (result.ok && generation == generation_) {
+            setModified(false);
+        }
+    });
 }
 
 void DialogView::onDialogSaveAs()
@@ -806,20 +827,7 @@ void DialogView::onDialogSaveAs()
     auto fn = QFileDialog::getSaveFileName(this, "Save As..", path_, "Dlg (*.dlg *.dlg.json)");
     if (fn.isEmpty()) { return; }
     path_ = fn;
-
-    QFileInfo fileInfo(path_);
-    auto ext = fileInfo.completeSuffix();
-    if (0 == ext.compare("dlg", Qt::CaseInsensitive)) {
-        nw::GffBuilder oa = nw::serialize(model_->dialog());
-        oa.write_to(path_.toStdString());
-        setModified(false);
-    } else if (0 == ext.compare("dlg.json", Qt::CaseInsensitive)) {
-        nlohmann::json j;
-        nw::serialize(j, *model_->dialog());
-        std::ofstream f{path_.toStdString()};
-        f << std::setw(4) << j;
-        setModified(false);
-    }
+    onDialogSave();
 }
 
 void DialogView::onDialogTextChanged()
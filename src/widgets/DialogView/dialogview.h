@@ -83,6 +83,8 @@ signals:
     void dataChanged(bool changed);
 
 private:
+    SaveWriter makeSaveWriter() const;
+
     Ui::DialogView* ui;
     QString path_;
     DialogModel* model_ = nullptr;
@@ -108,6 +110,7 @@ private:
     QMediaPlayer* player_ = nullptr;
     QAudioOutput* output_ = nullptr;
     bool modified_ = false;
+    uint64_t generation_ = 0;
 };
 
 #endif // DIALOGVIEW_H
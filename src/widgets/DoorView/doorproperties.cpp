@@ -26,6 +26,7 @@ void DoorProperties::setObject(nw::Door* obj)
     if (obj_) { return; }
     obj_ = obj;
 
+    beginUpdate();
     appearanceLoad();
     basicsLoad();
     conversationLoad();
@@ -34,6 +35,7 @@ void DoorProperties::setObject(nw::Door* obj)
     scriptsLoad();
     transitionLoad();
     trapsLoad();
+    endUpdate();
 }
 
 void DoorProperties::appearanceLoad()
@@ -4,6 +4,7 @@
 #include "../VariableTableView/variabletableview.h"
 #include "../loadscreensview.h"
 #include "../strreftextedit.h"
+#include "../util/objects.h"
 #include "../util/strings.h"
 #include "doorgeneralview.h"
 
@@ -15,7 +16,7 @@
 #include <QTextEdit>
 
 DoorView::DoorView(nw::Resource res, QWidget* parent)
-    : DoorView(nw::kernel::objects().load<nw::Door>(res.resref), parent)
+    : DoorView(load_object<nw::Door>(res), parent)
 {
     owned_ = true;
 }
@@ -36,27 +37,36 @@ DoorView::DoorView(nw::Door* obj, QWidget* parent)
     ui->tabWidget->addTab(general, "General");
     addTab(general);
 
-    auto loadscreens = new LoadscreensView(obj_->loadscreen, this);
-    loadscreens->setEnabled(!readOnly());
-    ui->tabWidget->addTab(loadscreens, tr("Loadscreens"));
-    addTab(loadscreens);
-    connect(loadscreens, &LoadscreensView::valueChanged, this, [this](int value) {
-        obj_->loadscreen = uint16_t(value);
+    // Remaining tabs are built the first time they're shown.
+    addLazyTab(ui->tabWidget, tr("Loadscreens"), [this]() {
+        auto loadscreens = new LoadscreensView(obj_->loadscreen, this);
+        loadscreens->setEnabled(!readOnly());
+        addTab(loadscreens);
+        connect(loadscreens, &LoadscreensView::valueChanged, this, [this](int value) {
+            obj_->loadscreen = uint16_t(value);
+        });
+        return loadscreens;
     });
 
-    auto variables = new VariableTableView(this);
-    variables->setEnabled(!readOnly());
-    variables->setLocals(&obj_->common.locals);
-    ui->tabWidget->addTab(variables, tr("Variables"));
-    addTab(variables);
+    addLazyTab(ui->tabWidget, tr("Variables"), [this]() {
+        auto variables = new VariableTableView(this);
+        variables->setEnabled(!readOnly());
+        variables->setLocals(&obj_->common.locals);
+        addTab(variables);
+        return variables;
+    });
 
-    auto description = new StrrefTextEdit(this);
-    description->setLocstring(obj->description);
-    ui->tabWidget->addTab(description, "Description");
+    addLazyTab(ui->tabWidget, "Description", [this]() {
+        auto description = new StrrefTextEdit(this);
+        description->setLocstring(obj_->description);
+        return description;
+    });
 
-    auto comments = new QTextEdit(this);
-    comments->setText(to_qstring(obj_->common.comment));
-    ui->tabWidget->addTab(comments, "Comments");
+    addLazyTab(ui->tabWidget, "Comments", [this]() {
+        auto comments = new QTextEdit(this);
+        comments->setText(to_qstring(obj_->common.comment));
+        return comments;
+    });
 
     loadModel();
     connect(ui->tabWidget, &QTabWidget::currentChanged, this, &DoorView::onTabChanged);
@@ -78,8 +88,7 @@ void DoorView::loadModel()
         if (genericdoors) {
             std::string model;
             if (genericdoors->get_to(obj_->generic_type, "ModelName", model)) {
-                auto mdl = load_model(model);
-                ui->openGLWidget->setModel(std::move(mdl));
+                ui->openGLWidget->setModelLoader([model]() { return load_model(model); });
             }
         } else {
             throw std::runtime_error("[door] failed to load genericdoors.2da");
@@ -89,8 +98,7 @@ void DoorView::loadModel()
         if (doortypes) {
             std::string model;
             if (doortypes->get_to(obj_->appearance, "Model", model)) {
-                auto mdl = load_model(model);
-                ui->openGLWidget->setModel(std::move(mdl));
+                ui->openGLWidget->setModelLoader([model]() { return load_model(model); });
             }
         } else {
             throw std::runtime_error("[door] failed to load doortypes.2da");
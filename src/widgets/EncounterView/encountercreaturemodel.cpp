@@ -15,11 +15,11 @@
 // == Undo Commands ===========================================================
 // ============================================================================
 
-class AddEncounterCreatureCommand : public QUndoCommand {
+class AddEncounterCreatureCommand : public HistoryCommand {
 public:
     AddEncounterCreatureCommand(nw::Encounter* enc, const nw::SpawnCreature& creature,
         EncounterCreatureModel* model, QUndoCommand* parent = nullptr)
-        : QUndoCommand(parent)
+        : HistoryCommand(parent)
         , enc_(enc)
         , creature_(creature)
         , model_{model}
@@ -27,16 +27,26 @@ public:
         setText(QString("Add creature %1").arg(QString::fromStdString(creature.name)));
     }
 
+    qsizetype cost() const override
+    {
+        return HistoryCommand::cost() + qsizetype(sizeof(nw::SpawnCreature) + creature_.name.size());
+    }
+
     void undo() override
     {
+        if (!restore()) { return; }
         model_->removeRows(int(enc_->creatures.size() - 1), 1);
     }
 
     void redo() override
     {
+        if (!restore()) { return; }
         model_->add(creature_);
     }
 
+protected:
+    void release() override { creature_ = {}; }
+
 private:
     nw::Encounter* enc_;
     nw::SpawnCreature creature_;
@@ -44,7 +54,7 @@ private:
 };
 
 RemoveEncounterCreatureCommand::RemoveEncounterCreatureCommand(nw::SpawnCreature creature, int index, EncounterCreatureModel* model, QUndoCommand* parent)
-    : QUndoCommand(parent)
+    : HistoryCommand(parent)
     , index_(index)
     , creature_(creature)
     , model_{model}
@@ -52,21 +62,33 @@ RemoveEncounterCreatureCommand::RemoveEncounterCreatureCommand(nw::SpawnCreature
     setText(QString("Remove creature %1").arg(QString::fromStdString(creature_.name)));
 }
 
+qsizetype RemoveEncounterCreatureCommand::cost() const
+{
+    return HistoryCommand::cost() + qsizetype(sizeof(nw::SpawnCreature) + creature_.name.size());
+}
+
 void RemoveEncounterCreatureCommand::undo()
 {
+    if (!restore()) { return; }
     model_->add(creature_, index_);
 }
 
 void RemoveEncounterCreatureCommand::redo()
 {
+    if (!restore()) { return; }
     model_->removeRows(index_, 1);
 }
 
-class SetCreatureUniqueCommand : public QUndoCommand {
+void RemoveEncounterCreatureCommand::release()
+{
+    creature_ = {};
+}
+
+class SetCreatureUniqueCommand : public HistoryCommand {
 public:
     SetCreatureUniqueCommand(nw::Encounter* enc, int index, bool unique,
         EncounterCreatureModel* model, QUndoCommand* parent = nullptr)
-        : QUndoCommand(parent)
+        : HistoryCommand(parent)
         , enc_(enc)
         , index_(index)
         , previous_(!unique)
@@ -80,6 +102,7 @@ public:
 
     void undo() override
     {
+        if (!restore()) { return; }
         enc_->creatures[index_].single_spawn = previous_;
         QModelIndex idx = model_->index(index_, 4);
         emit model_->dataChanged(idx, idx, {Qt::EditRole});
@@ -87,6 +110,7 @@ public:
 
     void redo() override
     {
+        if (!restore()) { return; }
         enc_->creatures[index_].single_spawn = next_;
         QModelIndex idx = model_->index(index_, 4);
         emit model_->dataChanged(idx, idx, {Qt::EditRole});
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "../util/undohistory.h"
+
 #include "nw/objects/Encounter.hpp"
 
 #include <QAbstractTableModel>
@@ -7,14 +9,18 @@
 
 class EncounterCreatureModel;
 
-class RemoveEncounterCreatureCommand : public QUndoCommand {
+class RemoveEncounterCreatureCommand : public HistoryCommand {
 public:
     RemoveEncounterCreatureCommand(nw::SpawnCreature creature, int index,
         EncounterCreatureModel* model, QUndoCommand* parent = nullptr);
 
+    qsizetype cost() const override;
     void undo() override;
     void redo() override;
 
+protected:
+    void release() override;
+
 private:
     int index_;
     nw::SpawnCreature creature_;
@@ -50,6 +50,7 @@ EncounterPropsView::~EncounterPropsView()
 void EncounterPropsView::loadProperties()
 {
     ui->properties->setUndoStack(undoStack());
+    ui->properties->beginUpdate();
 
     Property* prop = nullptr;
 
@@ -144,6 +145,7 @@ void EncounterPropsView::loadProperties()
     ADD_SCRIPT("On Heartbeat", on_heartbeat);
     ADD_SCRIPT("On User Defined", on_user_defined);
     ui->properties->addProperty(grp_scripts);
+    ui->properties->endUpdate();
 
 #undef ADD_SCRIPT
 }
@@ -2,6 +2,7 @@
 #include "ui_encounterview.h"
 
 #include "../VariableTableView/variabletableview.h"
+#include "../util/objects.h"
 #include "../util/strings.h"
 #include "encounterpropsview.h"
 
@@ -11,7 +12,7 @@
 #include <QTextEdit>
 
 EncounterView::EncounterView(nw::Resource res, QWidget* parent)
-    : EncounterView(nw::kernel::objects().load<nw::Encounter>(res.resref), parent)
+    : EncounterView(load_object<nw::Encounter>(res), parent)
 {
     owned_ = true;
 }
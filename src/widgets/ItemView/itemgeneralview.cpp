@@ -9,6 +9,7 @@
 #include "../util/itemmodels.h"
 #include "../util/objects.h"
 #include "../util/strings.h"
+#include "../util/undohistory.h"
 #include "itemsimplemodelselectordialog.h"
 
 #include "nw/kernel/Rules.hpp"
@@ -237,6 +238,7 @@ ItemGeneralView::ItemGeneralView(nw::Item* obj, ItemView* parent)
     , undo_{new QUndoStack(this)}
 {
     ui->setupUi(this);
+    UndoHistory::attach(undo_);
 
     mvpal_cloth_ = QPixmap(":/resources/images/mvpal_cloth.png");
     mvpal_leather_ = QPixmap(":/resources/images/mvpal_leather.png");
@@ -4,6 +4,7 @@
 #include "../proxymodels.h"
 #include "../statictwodamodel.h"
 #include "../util/strings.h"
+#include "../util/undohistory.h"
 #include "itemview.h"
 
 #include "nw/kernel/EffectSystem.hpp"
@@ -11,6 +12,7 @@
 #include "nw/kernel/Strings.hpp"
 
 #include <QComboBox>
+#include <QDataStream>
 #include <QHelpEvent>
 #include <QShortcut>
 #include <QToolTip>
@@ -18,28 +20,39 @@
 // == Undo Commands ===========================================================
 // ============================================================================
 
-class AddPropertyCommand : public QUndoCommand {
+class AddPropertyCommand : public HistoryCommand {
 public:
     AddPropertyCommand(ItemPropertiesModel* model, const nw::ItemProperty& prop)
         : model_(model)
         , property_(prop)
     {
     }
+
+    qsizetype cost() const override
+    {
+        return HistoryCommand::cost() + qsizetype(sizeof(nw::ItemProperty));
+    }
+
     void undo() override
     {
+        if (!restore()) { return; }
         model_->removePropertyNoCmd(model_->rowCount() - 1);
     }
     void redo() override
     {
+        if (!restore()) { return; }
         model_->addPropertyNoCmd(property_);
     }
 
+protected:
+    void release() override { property_ = {}; }
+
 private:
     ItemPropertiesModel* model_;
     nw::ItemProperty property_;
 };
 
-class RemovePropertyCommand : public QUndoCommand {
+class RemovePropertyCommand : public HistoryCommand {
 public:
     RemovePropertyCommand(ItemPropertiesModel* model, int row)
         : model_(model)
@@ -48,23 +61,33 @@ public:
     {
     }
 
+    qsizetype cost() const override
+    {
+        return HistoryCommand::cost() + qsizetype(sizeof(nw::ItemProperty));
+    }
+
     void undo() override
     {
+        if (!restore()) { return; }
         model_->insertPropertyNoCmd(row_, property_);
     }
 
     void redo() override
     {
+        if (!restore()) { return; }
         model_->removePropertyNoCmd(row_);
     }
 
+protected:
+    void release() override { property_ = {}; }
+
 private:
     ItemPropertiesModel* model_;
     int row_;
     nw::ItemProperty property_;
 };
 
-class ModifyPropertyCommand : public QUndoCommand {
+class ModifyPropertyCommand : public HistoryCommand {
 public:
     ModifyPropertyCommand(ItemPropertiesModel* model, const QModelIndex& index,
         const QVariant& newValue, const QVariant& oldValue)
@@ -75,16 +98,33 @@ public:
     {
     }
 
+    qsizetype cost() const override
+    {
+        return HistoryCommand::cost() + variant_cost(oldValue_) + variant_cost(newValue_);
+    }
+
     void undo() override
     {
+        if (!restore()) { return; }
         model_->setDataNoCmd(index_, oldValue_);
     }
 
     void redo() override
     {
+        if (!restore()) { return; }
         model_->setDataNoCmd(index_, newValue_);
     }
 
+protected:
+    bool canSpill() const override { return variant_streamable(oldValue_) && variant_streamable(newValue_); }
+    void save(QDataStream& stream) const override { stream << oldValue_ << newValue_; }
+    void load(QDataStream& stream) override { stream >> oldValue_ >> newValue_; }
+    void release() override
+    {
+        oldValue_ = {};
+        newValue_ = {};
+    }
+
 private:
     ItemPropertiesModel* model_;
     QPersistentModelIndex index_;
@@ -333,6 +373,7 @@ ItemProperties::ItemProperties(nw::Item* obj, ItemView* parent)
     , undo_{new QUndoStack(this)}
 {
     ui->setupUi(this);
+    UndoHistory::attach(undo_);
 
     loadAllProperties();
     model_ = new ItemPropertiesModel(obj_, undo_, this);
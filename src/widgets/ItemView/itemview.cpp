@@ -5,6 +5,7 @@
 #include "../InventoryView/inventoryview.h"
 #include "../VariableTableView/variabletableview.h"
 #include "../strreftextedit.h"
+#include "../util/objects.h"
 #include "../util/strings.h"
 #include "itemgeneralview.h"
 #include "itemproperties.h"
@@ -22,7 +23,7 @@ static QRegularExpression resref_regex("^[a-z_]{0,16}$");
 // ============================================================================
 
 ItemView::ItemView(nw::Resource res, QWidget* parent)
-    : ItemView(nw::kernel::objects().load<nw::Item>(res.resref), parent)
+    : ItemView(load_object<nw::Item>(res), parent)
 {
     owned_ = true;
 }
@@ -45,31 +46,43 @@ ItemView::ItemView(nw::Item* obj, QWidget* parent)
     ui->tabWidget->addTab(general, tr("General"));
     connect(general, &ItemGeneralView::baseItemChanged, this, &ItemView::onBaseItemChanged);
 
-    auto properties = new ItemProperties(obj_, this);
-    properties->setEnabled(!readOnly());
-    ui->tabWidget->addTab(properties, tr("Properties"));
-
-    inventory_ = new InventoryView(this);
-    inventory_->setEnabled(!readOnly() && bi_info->is_container);
-    inventory_->setObject(obj_, &obj_->inventory);
-    inventory_->setDragEnabled(false);
-    ui->tabWidget->addTab(inventory_, tr("Inventory"));
-
-    auto variables = new VariableTableView(this);
-    variables->setEnabled(!readOnly());
-    variables->setLocals(&obj_->common.locals);
-    ui->tabWidget->addTab(variables, tr("Variables"));
-
-    auto description = new StrrefTextEdit(this);
-    description->setEnabled(!readOnly());
-    description->setLocstring(obj->description);
-    ui->tabWidget->addTab(description, tr("Description"));
-
-    auto comments = new QTextEdit(this);
-    comments->setEnabled(!readOnly());
-    comments->setProperty("last_text", to_qstring(obj_->common.comment));
-    comments->setText(to_qstring(obj_->common.comment));
-    ui->tabWidget->addTab(comments, tr("Comments"));
+    // Remaining tabs are built the first time they're shown.
+    addLazyTab(ui->tabWidget, tr("Properties"), [this]() {
+        auto properties = new ItemProperties(obj_, this);
+        properties->setEnabled(!readOnly());
+        return properties;
+    });
+
+    addLazyTab(ui->tabWidget, tr("Inventory"), [this]() {
+        auto info = nw::kernel::rules().baseitems.get(obj_->baseitem);
+        inventory_ = new InventoryView(this);
+        inventory_->setEnabled(!readOnly() && info && info->is_container);
+        inventory_->setObject(obj_, &obj_->inventory);
+        inventory_->setDragEnabled(false);
+        return inventory_;
+    });
+
+    addLazyTab(ui->tabWidget, tr("Variables"), [this]() {
+        auto variables = new VariableTableView(this);
+        variables->setEnabled(!readOnly());
+        variables->setLocals(&obj_->common.locals);
+        return variables;
+    });
+
+    addLazyTab(ui->tabWidget, tr("Description"), [this]() {
+        auto description = new StrrefTextEdit(this);
+        description->setEnabled(!readOnly());
+        description->setLocstring(obj_->description);
+        return description;
+    });
+
+    addLazyTab(ui->tabWidget, tr("Comments"), [this]() {
+        auto comments = new QTextEdit(this);
+        comments->setEnabled(!readOnly());
+        comments->setProperty("last_text", to_qstring(obj_->common.comment));
+        comments->setText(to_qstring(obj_->common.comment));
+        return comments;
+    });
 
     connect(ui->tabWidget, &QTabWidget::currentChanged, this, &ItemView::onTabChanged);
 }
@@ -82,7 +95,7 @@ ItemView::~ItemView()
 void ItemView::onBaseItemChanged(nw::BaseItem bi)
 {
     auto bi_info = nw::kernel::rules().baseitems.get(bi);
-    if (!bi_info || !bi_info->valid()) { return; }
+    if (!bi_info || !bi_info->valid() || !inventory_) { return; }
     inventory_->setEnabled(!readOnly() && bi_info->is_container);
 }
 
@@ -39,7 +39,7 @@ private:
     Ui::ItemView* ui;
     nw::Item* obj_;
     bool owned_ = false;
-    InventoryView* inventory_;
+    InventoryView* inventory_ = nullptr;
 };
 
 #endif // ITEMVIEW_H
@@ -25,12 +25,14 @@ void PlaceableProperties::setObject(nw::Placeable* obj)
     if (obj_) { return; }
     obj_ = obj;
 
+    beginUpdate();
     basicsLoad();
     conversationLoad();
     locksLoad();
     savesLoad();
     scriptsLoad();
     trapsLoad();
+    endUpdate();
 }
 
 // == Private Methods =========================================================
@@ -4,6 +4,7 @@
 #include "../InventoryView/inventoryview.h"
 #include "../VariableTableView/variabletableview.h"
 #include "../strreftextedit.h"
+#include "../util/objects.h"
 #include "../util/strings.h"
 #include "placeablegeneralview.h"
 
@@ -15,7 +16,7 @@
 #include <QTextEdit>
 
 PlaceableView::PlaceableView(nw::Resource res, QWidget* parent)
-    : PlaceableView(nw::kernel::objects().load<nw::Placeable>(res.resref), parent)
+    : PlaceableView(load_object<nw::Placeable>(res), parent)
 {
     owned_ = true;
 }
@@ -36,28 +37,37 @@ PlaceableView::PlaceableView(nw::Placeable* obj, QWidget* parent)
     ui->tabWidget->addTab(general, "General");
     connect(general, &PlaceableGeneralView::modificationChanged, this, &PlaceableView::onModificationChanged);
 
-    inventory_ = new InventoryView(this);
-    inventory_->setEnabled(!readOnly() && obj_->has_inventory);
-    inventory_->setObject(obj_, &obj_->inventory);
-    inventory_->setDragEnabled(false);
-    ui->tabWidget->addTab(inventory_, tr("Inventory"));
-
-    auto variables = new VariableTableView(this);
-    variables->setEnabled(!readOnly());
-    variables->setLocals(&obj_->common.locals);
-    ui->tabWidget->addTab(variables, tr("Variables"));
-    connect(variables, &VariableTableView::modificationChanged, this, &PlaceableView::onModificationChanged);
-
-    auto description = new StrrefTextEdit(this);
-    description->setEnabled(!readOnly());
-    description->setLocstring(obj->description);
-    ui->tabWidget->addTab(description, tr("Description"));
-
-    auto comments = new QTextEdit(this);
-    comments->setEnabled(!readOnly());
-    comments->setProperty("last_text", to_qstring(obj_->common.comment));
-    comments->setText(to_qstring(obj_->common.comment));
-    ui->tabWidget->addTab(comments, tr("Comments"));
+    // Remaining tabs are built the first time they're shown.
+    addLazyTab(ui->tabWidget, tr("Inventory"), [this]() {
+        inventory_ = new InventoryView(this);
+        inventory_->setEnabled(!readOnly() && obj_->has_inventory);
+        inventory_->setObject(obj_, &obj_->inventory);
+        inventory_->setDragEnabled(false);
+        return inventory_;
+    });
+
+    addLazyTab(ui->tabWidget, tr("Variables"), [this]() {
+        auto variables = new VariableTableView(this);
+        variables->setEnabled(!readOnly());
+        variables->setLocals(&obj_->common.locals);
+        connect(variables, &VariableTableView::modificationChanged, this, &PlaceableView::onModificationChanged);
+        return variables;
+    });
+
+    addLazyTab(ui->tabWidget, tr("Description"), [this]() {
+        auto description = new StrrefTextEdit(this);
+        description->setEnabled(!readOnly());
+        description->setLocstring(obj_->description);
+        return description;
+    });
+
+    addLazyTab(ui->tabWidget, tr("Comments"), [this]() {
+        auto comments = new QTextEdit(this);
+        comments->setEnabled(!readOnly());
+        comments->setProperty("last_text", to_qstring(obj_->common.comment));
+        comments->setText(to_qstring(obj_->common.comment));
+        return comments;
+    });
 
     loadModel();
     connect(general, &PlaceableGeneralView::appearanceChanged, this, &PlaceableView::loadModel);
@@ -70,29 +80,32 @@ PlaceableView::~PlaceableView()
 
 void PlaceableView::loadModel()
 {
-    LOG_F(INFO, "loadModel called for appearance: {}", obj_->appearance);
-    auto plc = nw::kernel::rules().placeables.get(nw::PlaceableType::make(obj_->appearance));
-    if (!plc) {
-        LOG_F(ERROR, "No placeable data for appearance: {}", obj_->appearance);
-        return;
-    }
-    if (plc->model.empty()) {
-        LOG_F(WARNING, "Empty model string for appearance: {}", obj_->appearance);
-        return;
-    }
-
-    LOG_F(INFO, "Loading model: {}", plc->model.view());
-    auto model = load_model(plc->model.view());
-    if (!model) {
-        LOG_F(ERROR, "Failed to load model: {}", plc->model.view());
-        return;
-    }
-    LOG_F(INFO, "Model loaded: {}, nodes={}", plc->model.view(), model->nodes_.size());
-    ui->openGLWidget->setModel(std::move(model));
-    LOG_F(INFO, "Model set on RenderWidget");
+    // Loading is deferred until the viewport is actually visible.
+    ui->openGLWidget->setModelLoader([appearance = obj_->appearance]() -> std::unique_ptr<Model> {
+        LOG_F(INFO, "loadModel called for appearance: {}", appearance);
+        auto plc = nw::kernel::rules().placeables.get(nw::PlaceableType::make(appearance));
+        if (!plc) {
+            LOG_F(ERROR, "No placeable data for appearance: {}", appearance);
+            return nullptr;
+        }
+        if (plc->model.empty()) {
+            LOG_F(WARNING, "Empty model string for appearance: {}", appearance);
+            return nullptr;
+        }
+
+        LOG_F(INFO, "Loading model: {}", plc->model.view());
+        auto model = load_model(plc->model.view());
+        if (!model) {
+            LOG_F(ERROR, "Failed to load model: {}", plc->model.view());
+            return nullptr;
+        }
+        LOG_F(INFO, "Model loaded: {}, nodes={}", plc->model.view(), model->nodes_.size());
+        return model;
+    });
 }
 
 void PlaceableView::onHasInvetoryChanged(bool value)
 {
+    if (!inventory_) { return; }
     inventory_->setEnabled(value);
 }
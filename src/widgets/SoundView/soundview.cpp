@@ -2,6 +2,7 @@
 #include "ui_soundview.h"
 
 #include "../VariableTableView/variabletableview.h"
+#include "../util/objects.h"
 #include "../util/strings.h"
 #include "soundgeneralview.h"
 
@@ -10,7 +11,7 @@
 #include <QTextEdit>
 
 SoundView::SoundView(nw::Resource res, QWidget* parent)
-    : SoundView(nw::kernel::objects().load<nw::Sound>(res.resref), parent)
+    : SoundView(load_object<nw::Sound>(res), parent)
 {
     owned_ = true;
 }
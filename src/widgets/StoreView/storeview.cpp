@@ -2,6 +2,7 @@
 #include "ui_storeview.h"
 
 #include "../VariableTableView/variabletableview.h"
+#include "../util/objects.h"
 #include "../util/strings.h"
 #include "storegeneralview.h"
 #include "storeinventoryview.h"
@@ -15,7 +16,7 @@
 // ============================================================================
 
 StoreView::StoreView(nw::Resource res, QWidget* parent)
-    : StoreView(nw::kernel::objects().load<nw::Store>(res.resref), parent)
+    : StoreView(load_object<nw::Store>(res), parent)
 {
     owned_ = true;
 }
@@ -32,20 +33,27 @@ StoreView::StoreView(nw::Store* obj, QWidget* parent)
     ui->tabWidget->addTab(gen, "General");
     addTab(gen);
 
-    auto inv = new StoreInventoryView(obj_, this);
-    inv->setEnabled(!readOnly());
-    ui->tabWidget->addTab(inv, "Inventory");
-    addTab(inv);
-
-    auto variables = new VariableTableView(this);
-    variables->setEnabled(!readOnly());
-    variables->setLocals(&obj_->common.locals);
-    ui->tabWidget->addTab(variables, tr("Variables"));
-    addTab(variables);
-
-    auto comments = new QTextEdit(this);
-    comments->setText(to_qstring(obj_->common.comment));
-    ui->tabWidget->addTab(comments, "Comments");
+    // Remaining tabs are built the first time they're shown.
+    addLazyTab(ui->tabWidget, "Inventory", [this]() {
+        auto inv = new StoreInventoryView(obj_, this);
+        inv->setEnabled(!readOnly());
+        addTab(inv);
+        return inv;
+    });
+
+    addLazyTab(ui->tabWidget, tr("Variables"), [this]() {
+        auto variables = new VariableTableView(this);
+        variables->setEnabled(!readOnly());
+        variables->setLocals(&obj_->common.locals);
+        addTab(variables);
+        return variables;
+    });
+
+    addLazyTab(ui->tabWidget, "Comments", [this]() {
+        auto comments = new QTextEdit(this);
+        comments->setText(to_qstring(obj_->common.comment));
+        return comments;
+    });
 }
 
 StoreView::~StoreView()
@@ -10,6 +10,18 @@ TlkModel::TlkModel(nw::Tlk* tlk, QObject* parent)
 {
 }
 
+void TlkModel::setFilter(std::optional<std::vector<uint32_t>> strrefs)
+{
+    beginResetModel();
+    filter_ = std::move(strrefs);
+    endResetModel();
+}
+
+uint32_t TlkModel::strref(int row) const
+{
+    return filter_ ? (*filter_)[size_t(row)] : static_cast<uint32_t>(row);
+}
+
 int TlkModel::columnCount(const QModelIndex& /*parent*/) const
 {
     return 1;
@@ -18,13 +30,22 @@ int TlkModel::columnCount(const QModelIndex& /*parent*/) const
 QVariant TlkModel::data(const QModelIndex& index, int role) const
 {
     if (role == Qt::DisplayRole) {
-        return to_qstring(tlk_->get(static_cast<uint32_t>(index.row())));
+        return to_qstring(tlk_->get(strref(index.row())));
     }
 
     return {};
 }
 
+QVariant TlkModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation == Qt::Vertical && role == Qt::DisplayRole) {
+        return strref(section);
+    }
+    return QAbstractTableModel::headerData(section, orientation, role);
+}
+
 int TlkModel::rowCount(const QModelIndex& /*parent*/) const
 {
-    return tlk_ ? static_cast<int>(tlk_->size()) : 0;
+    if (!tlk_) { return 0; }
+    return filter_ ? static_cast<int>(filter_->size()) : static_cast<int>(tlk_->size());
 }
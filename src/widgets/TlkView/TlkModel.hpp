@@ -4,14 +4,24 @@
 
 #include <QAbstractTableModel>
 
+#include <optional>
+#include <vector>
+
 class TlkModel : public QAbstractTableModel {
     Q_OBJECT
 
 public:
     explicit TlkModel(nw::Tlk* tlk, QObject* parent = nullptr);
 
+    /// Restricts rows to ``strrefs``, or shows every string if ``std::nullopt``
+    void setFilter(std::optional<std::vector<uint32_t>> strrefs);
+
+    /// Gets the strref displayed at ``row``
+    uint32_t strref(int row) const;
+
     int columnCount(const QModelIndex& parent = QModelIndex()) const override;
     QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
     int rowCount(const QModelIndex& parent = QModelIndex()) const override;
 
     // Qt::ItemFlags flags(const QModelIndex& index) const override;
@@ -23,4 +33,5 @@ public:
 
 private:
     nw::Tlk* tlk_ = nullptr;
+    std::optional<std::vector<uint32_t>> filter_;
 };
@@ -1,6 +1,8 @@
 #include "TlkView.hpp"
 #include "ui_TlkView.h"
 
+#include <QtConcurrent/QtConcurrent>
+
 TlkView::TlkView(nw::Tlk* tlk, QWidget* parent)
     : QFrame(parent)
     , ui_{std::make_unique<Ui::TlkView>()}
@@ -9,8 +11,39 @@ TlkView::TlkView(nw::Tlk* tlk, QWidget* parent)
 {
     ui_->setupUi(this);
     ui_->tableView->setModel(model_);
+    connect(ui_->searchEdit, &QLineEdit::textChanged, this, &TlkView::onSearchChanged);
+
+    if (!tlk_) { return; }
+
+    // Index is built in the background, searches typed before it's ready are applied once it is.
+    index_watcher_ = new QFutureWatcher<std::shared_ptr<const TlkIndex>>(this);
+    connect(index_watcher_, &QFutureWatcher<std::shared_ptr<const TlkIndex>>::finished, this, [this]() {
+        index_ = index_watcher_->result();
+        applySearch();
+    });
+    // The build works on a copy, so the view can close without waiting for it.
+    auto strings = copy_tlk_strings(*tlk_);
+    index_watcher_->setFuture(QtConcurrent::run([strings = std::move(strings)]() -> std::shared_ptr<const TlkIndex> {
+        auto index = std::make_shared<TlkIndex>();
+        index->add(strings);
+        return index;
+    }));
+}
+
+TlkView::~TlkView() = default;
+
+void TlkView::onSearchChanged(const QString& text)
+{
+    Q_UNUSED(text);
+    applySearch();
 }
 
-TlkView::~TlkView()
+void TlkView::applySearch()
 {
+    auto text = ui_->searchEdit->text();
+    if (text.isEmpty()) {
+        model_->setFilter(std::nullopt);
+    } else if (index_) {
+        model_->setFilter(index_->search(text.toStdString(), TlkIndex::unlimited));
+    }
 }
@@ -2,9 +2,12 @@
 
 #include "TlkModel.hpp"
 
+#include "../util/tlkindex.h"
+
 #include <nw/i18n/Tlk.hpp>
 
 #include <QFrame>
+#include <QFutureWatcher>
 
 #include <memory>
 
@@ -19,8 +22,15 @@ public:
     explicit TlkView(nw::Tlk* tlk, QWidget* parent = nullptr);
     ~TlkView();
 
+public slots:
+    void onSearchChanged(const QString& text);
+
 private:
+    void applySearch();
+
     std::unique_ptr<Ui::TlkView> ui_;
     nw::Tlk* tlk_ = nullptr;
     TlkModel* model_ = nullptr;
+    std::shared_ptr<const TlkIndex> index_;
+    QFutureWatcher<std::shared_ptr<const TlkIndex>>* index_watcher_ = nullptr;
 };
@@ -2,6 +2,7 @@
 #include "ui_triggerview.h"
 
 #include "../VariableTableView/variabletableview.h"
+#include "../util/objects.h"
 #include "triggergeneralview.h"
 
 // == TriggerView =============================================================
@@ -10,7 +11,7 @@
 #include "nw/kernel/Objects.hpp"
 
 TriggerView::TriggerView(nw::Resource res, QWidget* parent)
-    : TriggerView(nw::kernel::objects().load<nw::Trigger>(res.resref), parent)
+    : TriggerView(load_object<nw::Trigger>(res), parent)
 {
     owned_ = true;
 }
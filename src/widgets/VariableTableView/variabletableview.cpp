@@ -6,9 +6,11 @@
 #include "nw/objects/LocalData.hpp"
 
 #include "../util/strings.h"
+#include "../util/undohistory.h"
 #include "ZFontIcon/ZFontIcon.h"
 #include "ZFontIcon/ZFont_fa6.h"
 
+#include <QDataStream>
 #include <QLineEdit>
 #include <QMouseEvent>
 #include <QRegularExpressionValidator>
@@ -80,12 +82,12 @@ private:
     VarTableItem item_;
 };
 
-class VarTableModifyCommand : public QUndoCommand {
+class VarTableModifyCommand : public HistoryCommand {
 public:
     VarTableModifyCommand(VariableTableModel* model, const QModelIndex& index,
         const QVariant& oldValue, const QVariant& newValue,
         QUndoCommand* parent = nullptr)
-        : QUndoCommand(parent)
+        : HistoryCommand(parent)
         , model_(model)
         , row_(index.row())
         , column_(index.column())
@@ -95,16 +97,33 @@ public:
         setText("Modify Variable");
     }
 
+    qsizetype cost() const override
+    {
+        return HistoryCommand::cost() + variant_cost(oldValue_) + variant_cost(newValue_);
+    }
+
     void undo() override
     {
+        if (!restore()) { return; }
         doSetData(oldValue_);
     }
 
     void redo() override
     {
+        if (!restore()) { return; }
         doSetData(newValue_);
     }
 
+protected:
+    bool canSpill() const override { return variant_streamable(oldValue_) && variant_streamable(newValue_); }
+    void save(QDataStream& stream) const override { stream << oldValue_ << newValue_; }
+    void load(QDataStream& stream) override { stream >> oldValue_ >> newValue_; }
+    void release() override
+    {
+        oldValue_ = {};
+        newValue_ = {};
+    }
+
 private:
     void doSetData(const QVariant& value)
     {
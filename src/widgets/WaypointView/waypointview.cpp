@@ -2,12 +2,13 @@
 #include "ui_waypointview.h"
 
 #include "../VariableTableView/variabletableview.h"
+#include "../util/objects.h"
 #include "waypointgeneralview.h"
 
 #include "nw/kernel/Objects.hpp"
 
 WaypointView::WaypointView(nw::Resource res, QWidget* parent)
-    : WaypointView(nw::kernel::objects().load<nw::Waypoint>(res.resref), parent)
+    : WaypointView(load_object<nw::Waypoint>(res), parent)
 {
     owned_ = true;
 }
@@ -1,6 +1,7 @@
 #include "arclighttab.h"
 
 #include "ArclightView.h"
+#include "util/undohistory.h"
 
 #include <QShortcut>
 #include <QUndoStack>
@@ -9,6 +10,7 @@ ArclightTab::ArclightTab(ArclightView* parent)
     : QWidget{parent}
     , undo_{new QUndoStack(this)}
 {
+    UndoHistory::attach(undo_);
     connect(this, &ArclightTab::activateUndoStack, parent, &ArclightView::activateUndoStack);
 
     QShortcut* us = new QShortcut(QKeySequence::Undo, this);
@@ -1,5 +1,7 @@
 #include "propertybrowser.h"
 
+#include "util/undohistory.h"
+
 #include "nw/log.hpp"
 #include "xxhash/xxh3.h"
 
@@ -7,6 +9,7 @@
 #include <QCheckBox>
 #include <QColorDialog>
 #include <QComboBox>
+#include <QDataStream>
 #include <QHeaderView>
 #include <QLabel>
 #include <QLineEdit>
@@ -21,20 +24,24 @@
 // == Undo Commands ===========================================================
 // ============================================================================
 
-class PropertyValueCommand : public QUndoCommand {
+class PropertyValueCommand : public HistoryCommand {
 public:
     PropertyValueCommand(Property* property, const QVariant& oldValue,
         const QVariant& newValue, PropertyModel* model,
         QUndoCommand* parent = nullptr)
-        : QUndoCommand(parent)
+        : HistoryCommand(parent)
         , property_(property)
-        , oldValue_(oldValue)
-        , newValue_(newValue)
+        , delta_(oldValue, newValue)
         , model_(model)
     {
         setText(QString("Change %1").arg(property->name));
     }
 
+    qsizetype cost() const override
+    {
+        return HistoryCommand::cost() + delta_.cost();
+    }
+
     int id() const override
     {
         uint64_t hash = XXH3_64bits(reinterpret_cast<const void*>(property_), sizeof(property_));
@@ -46,52 +53,114 @@ public:
         const PropertyValueCommand* cmd = dynamic_cast<const PropertyValueCommand*>(other);
         if (!cmd) { return false; }
         if (property_ != cmd->property_) { return false; }
-        newValue_ = cmd->newValue_;
+        if (!coalesces() || !restore()) { return false; }
+
+        // ``other`` has already been applied, so the property holds the newest value.
+        auto current = property_->value;
+        auto previous = delta_.before(cmd->delta_.before(current));
+        delta_ = FieldDelta(previous, current);
+        setObsolete(previous == current);
+        touch();
         return true;
     }
 
     void undo() override
     {
         QModelIndex index = model_->indexForProperty(property_);
-        if (!index.isValid()) { return; }
-        property_->value = oldValue_;
-        if (property_->on_set) { property_->on_set(oldValue_); }
-        emit model_->dataChanged(index, index, {Qt::DisplayRole, Qt::EditRole});
+        if (!index.isValid() || !restore()) { return; }
+        setValue(index, delta_.before(property_->value));
     }
 
     void redo() override
     {
         QModelIndex index = model_->indexForProperty(property_);
-        if (!index.isValid()) { return; }
-        property_->value = newValue_;
-        if (property_->on_set) { property_->on_set(newValue_); }
-        emit model_->dataChanged(index, index, {Qt::DisplayRole, Qt::EditRole});
+        if (!index.isValid() || !restore()) { return; }
+        setValue(index, delta_.after(property_->value));
     }
 
+protected:
+    bool canSpill() const override { return delta_.streamable(); }
+    void save(QDataStream& stream) const override { stream << delta_; }
+    void load(QDataStream& stream) override { stream >> delta_; }
+    void release() override { delta_ = {}; }
+
 private:
+    void setValue(const QModelIndex& index, const QVariant& value)
+    {
+        property_->value = value;
+        if (property_->on_set) { property_->on_set(value); }
+        emit model_->dataChanged(index, index, {Qt::DisplayRole, Qt::EditRole});
+    }
+
     Property* property_;
-    QVariant oldValue_;
-    QVariant newValue_;
+    FieldDelta delta_;
     PropertyModel* model_;
 };
 
 // == Property ================================================================
 // ============================================================================
 
+namespace {
+
+// Refreshes cached rows after an insertion or removal at ``from``.
+void renumber(const QList<Property*>& properties, int from)
+{
+    for (int i = from; i < int(properties.size()); ++i) {
+        properties[i]->row = i;
+    }
+}
+
+// Refreshes cached rows of a whole subtree, children may have been reordered before it was added.
+void renumber_recursive(Property* prop)
+{
+    renumber(prop->children, 0);
+    for (auto child : prop->children) {
+        renumber_recursive(child);
+    }
+}
+
+template <typename Fn>
+void for_each_property(const QList<Property*>& properties, const Fn& fn)
+{
+    for (auto prop : properties) {
+        fn(prop);
+        for_each_property(prop->children, fn);
+    }
+}
+
+} // namespace
+
 Property::~Property()
 {
     removeFromParent();
+    // Detach first so children don't renumber their siblings one by one.
     foreach (auto child, children) {
+        child->parent = nullptr;
         delete child;
     }
 }
 
+void Property::appendChild(Property* child)
+{
+    child->parent = this;
+    child->row = int(children.size());
+    children.append(child);
+}
+
 void Property::removeFromParent()
 {
-    if (parent) {
-        parent->children.removeAll(this);
-        parent = nullptr;
+    if (!parent) { return; }
+
+    auto& siblings = parent->children;
+    int index = row;
+    if (index < 0 || index >= int(siblings.size()) || siblings[index] != this) {
+        index = int(siblings.indexOf(this));
     }
+    if (index >= 0) {
+        siblings.removeAt(index);
+        renumber(siblings, index);
+    }
+    parent = nullptr;
 }
 
 void Property::setEditable(bool val)
@@ -321,13 +390,23 @@ void PropertyModel::addProperty(Property* prop, Property* parent)
 
     int row = int(properties->size());
     QModelIndex pindex = parent
-        ? createIndex(int(properties_.indexOf(parent)), 0, parent)
+        ? createIndex(parent->row, 0, parent)
         : QModelIndex();
 
-    beginInsertRows(pindex, row, row);
+    if (!inBatch()) { beginInsertRows(pindex, row, row); }
     prop->parent = parent;
+    prop->row = row;
     properties->append(prop);
-    endInsertRows();
+    renumber_recursive(prop);
+    watchEnumModels(prop);
+    if (!inBatch()) { endInsertRows(); }
+}
+
+void PropertyModel::beginBatch()
+{
+    if (batch_depth_++ == 0) {
+        beginResetModel();
+    }
 }
 
 void PropertyModel::deleteProperty(Property* prop)
@@ -336,58 +415,52 @@ void PropertyModel::deleteProperty(Property* prop)
 
     QModelIndex index = indexForProperty(prop);
     if (index.isValid()) {
-        if (prop->parent) {
-            int row = int(prop->parent->children.indexOf(prop));
-            if (row >= 0) {
-                beginRemoveRows(indexForProperty(prop->parent), row, row);
-                prop->parent->children.removeAt(row);
-                endRemoveRows();
-            }
-        } else {
-            int row = int(properties_.indexOf(prop));
-            if (row >= 0) {
-                beginRemoveRows(QModelIndex(), row, row);
-                properties_.removeAt(row);
-                endRemoveRows();
-            }
-        }
+        QList<Property*>* properties = prop->parent ? &prop->parent->children : &properties_;
+        int row = prop->row;
+        if (!inBatch()) { beginRemoveRows(index.parent(), row, row); }
+        properties->removeAt(row);
+        renumber(*properties, row);
+        prop->parent = nullptr;
+        if (!inBatch()) { endRemoveRows(); }
     }
     delete prop;
 }
 
+void PropertyModel::endBatch()
+{
+    if (batch_depth_ > 0 && --batch_depth_ == 0) {
+        endResetModel();
+    }
+}
+
 QModelIndex PropertyModel::indexForProperty(Property* prop) const
 {
     if (!prop) { return QModelIndex(); }
 
-    int row;
-    if (prop->parent) {
-        row = int(prop->parent->children.indexOf(prop));
-        if (row == -1) { return QModelIndex(); }
-    } else {
-        row = int(properties_.indexOf(prop));
-        if (row == -1) { return QModelIndex(); }
+    const QList<Property*>& properties = prop->parent ? prop->parent->children : properties_;
+    if (prop->row < 0 || prop->row >= int(properties.size()) || properties[prop->row] != prop) {
+        return QModelIndex();
     }
 
-    return createIndex(row, ColumnValue, prop);
+    return createIndex(prop->row, ColumnValue, prop);
 }
 
 void PropertyModel::removeProperty(Property* prop)
 {
     if (!prop) { return; }
 
-    Property* parent = prop->parent;
-    QList<Property*>* properties = parent ? &parent->children : &properties_;
-
-    int row = int(properties->indexOf(prop));
-    if (row == -1) { return; }
+    QModelIndex index = indexForProperty(prop);
+    if (!index.isValid()) { return; }
 
-    QModelIndex parentIndex = parent ? indexForProperty(parent) : QModelIndex();
+    QList<Property*>* properties = prop->parent ? &prop->parent->children : &properties_;
+    int row = prop->row;
 
-    beginRemoveRows(parentIndex, row, row);
+    if (!inBatch()) { beginRemoveRows(index.parent(), row, row); }
     properties->removeAt(row);
-    endRemoveRows();
+    renumber(*properties, row);
+    prop->parent = nullptr;
+    if (!inBatch()) { endRemoveRows(); }
 
-    prop->removeFromParent();
     delete prop;
 }
 
@@ -395,19 +468,20 @@ void PropertyModel::replaceProperty(Property* old, Property* replacement)
 {
     if (!old || !replacement) { return; }
 
-    Property* parent = old->parent;
+    QModelIndex index = indexForProperty(old);
+    if (!index.isValid()) { return; }
 
+    Property* parent = old->parent;
     QList<Property*>* properties = parent ? &parent->children : &properties_;
+    int row = old->row;
 
-    int row = int(properties->indexOf(old));
-    if (row == -1) { return; }
-
-    QModelIndex parentIndex = parent ? indexForProperty(parent) : QModelIndex();
-
-    beginInsertRows(parentIndex, row, row);
+    if (!inBatch()) { beginInsertRows(index.parent(), row, row); }
     properties->insert(row, replacement);
     replacement->parent = parent;
-    endInsertRows();
+    renumber(*properties, row);
+    renumber_recursive(replacement);
+    watchEnumModels(replacement);
+    if (!inBatch()) { endInsertRows(); }
 
     removeProperty(old);
 }
@@ -458,12 +532,7 @@ QVariant PropertyModel::data(const QModelIndex& index, int role) const
             break;
         case Qt::DisplayRole:
             if (prop->type == PropertyType2::Enum && prop->enum_config.model) {
-                int row = prop->value.toInt();
-                auto row_count = prop->enum_config.model->rowCount();
-                if (row < 0 && row >= row_count) { return {}; }
-                auto idx = prop->enum_config.model->index(row, 0);
-                if (!idx.isValid()) { return {}; }
-                result = idx.data();
+                result = enumDisplay(prop);
             } else {
                 result = prop->value;
             }
@@ -480,6 +549,62 @@ QVariant PropertyModel::data(const QModelIndex& index, int role) const
     return result;
 }
 
+QVariant PropertyModel::enumDisplay(Property* prop) const
+{
+    auto& config = prop->enum_config;
+    int row = prop->value.toInt();
+    auto generation = enumGeneration(config.model);
+    if (config.display_row == row && config.display_generation == generation) {
+        return config.display;
+    }
+
+    config.display = {};
+    if (row >= 0 && row < config.model->rowCount()) {
+        config.display = config.model->index(row, 0).data();
+    }
+    config.display_row = row;
+    config.display_generation = generation;
+    return config.display;
+}
+
+quint64 PropertyModel::enumGeneration(QAbstractItemModel* model) const
+{
+    return enum_generations_.value(model, 0);
+}
+
+void PropertyModel::enumModelChanged(QAbstractItemModel* model)
+{
+    ++enum_generations_[model];
+    // A batch resets the model when it ends, which covers these rows.
+    if (inBatch()) { return; }
+
+    for_each_property(properties_, [this, model](Property* prop) {
+        if (prop->type != PropertyType2::Enum || prop->enum_config.model != model) { return; }
+        auto index = indexForProperty(prop);
+        if (index.isValid()) { emit dataChanged(index, index, {Qt::DisplayRole}); }
+    });
+}
+
+void PropertyModel::watchEnumModels(Property* prop)
+{
+    for_each_property({prop}, [this](Property* p) {
+        auto model = p->type == PropertyType2::Enum ? p->enum_config.model : nullptr;
+        if (!model || enum_generations_.contains(model)) { return; }
+
+        enum_generations_.insert(model, 1);
+        auto changed = [this, model]() { enumModelChanged(model); };
+        connect(model, &QAbstractItemModel::dataChanged, this, changed);
+        connect(model, &QAbstractItemModel::layoutChanged, this, changed);
+        connect(model, &QAbstractItemModel::modelReset, this, changed);
+        connect(model, &QAbstractItemModel::rowsInserted, this, changed);
+        connect(model, &QAbstractItemModel::rowsRemoved, this, changed);
+        connect(model, &QAbstractItemModel::rowsMoved, this, changed);
+        connect(model, &QObject::destroyed, this, [this, model]() {
+            enum_generations_.remove(model);
+        });
+    });
+}
+
 Qt::ItemFlags PropertyModel::flags(const QModelIndex& index) const
 {
     if (!index.isValid()) { return Qt::NoItemFlags; }
@@ -535,10 +660,7 @@ QModelIndex PropertyModel::parent(const QModelIndex& index) const
     Property* pp = cp->parent;
     if (!pp) { return {}; }
 
-    Property* gpp = pp->parent;
-    const QList<Property*>* siblings = gpp ? &gpp->children : &properties_;
-
-    return createIndex(int(siblings->indexOf(pp)), 0, pp);
+    return createIndex(pp->row, 0, pp);
 }
 
 int PropertyModel::rowCount(const QModelIndex& parent) const
@@ -596,8 +718,7 @@ Property* PropertyBrowser::makeGroup(QString name, Property* parent)
     result->type = PropertyType2::Group;
     result->read_only = true;
     if (parent) {
-        result->parent = parent;
-        result->parent->children.append(result);
+        parent->appendChild(result);
     }
 
     return result;
@@ -609,9 +730,8 @@ Property* PropertyBrowser::makeBoolProperty(QString name, bool value, Property*
     result->name = std::move(name);
     result->value = value;
     result->type = PropertyType2::Boolean;
-    result->parent = parent;
-    if (result->parent) {
-        result->parent->children.append(result);
+    if (parent) {
+        parent->appendChild(result);
     }
     return result;
 }
@@ -623,8 +743,7 @@ Property* PropertyBrowser::makeDoubleProperty(QString name, double value, Proper
     result->value = value;
     result->type = PropertyType2::Double;
     if (parent) {
-        result->parent = parent;
-        result->parent->children.append(result);
+        parent->appendChild(result);
     }
     return result;
 }
@@ -636,8 +755,7 @@ Property* PropertyBrowser::makeIntegerProperty(QString name, int value, Property
     result->value = value;
     result->type = PropertyType2::Integer;
     if (parent) {
-        result->parent = parent;
-        result->parent->children.append(result);
+        parent->appendChild(result);
     }
     return result;
 }
@@ -649,8 +767,7 @@ Property* PropertyBrowser::makeStringProperty(QString name, QString value, Prope
     result->value = value;
     result->type = PropertyType2::String;
     if (parent) {
-        result->parent = parent;
-        result->parent->children.append(result);
+        parent->appendChild(result);
     }
     return result;
 }
@@ -663,8 +780,7 @@ Property* PropertyBrowser::makeEnumProperty(QString name, int value, QAbstractIt
     result->type = PropertyType2::Enum;
     result->enum_config.model = model;
     if (parent) {
-        result->parent = parent;
-        result->parent->children.append(result);
+        parent->appendChild(result);
     }
     return result;
 }
@@ -672,6 +788,8 @@ Property* PropertyBrowser::makeEnumProperty(QString name, int value, QAbstractIt
 void PropertyBrowser::addProperty(Property* prop)
 {
     model_->addProperty(prop, prop->parent);
+    if (model_->inBatch()) { return; }
+
     QModelIndex propIndex = model_->indexForProperty(prop);
     if (propIndex.isValid()) {
         QModelIndex nameColIndex = model_->index(propIndex.row(), PropertyModel::ColumnName, propIndex.parent());
@@ -679,6 +797,11 @@ void PropertyBrowser::addProperty(Property* prop)
     }
 }
 
+void PropertyBrowser::beginUpdate()
+{
+    model_->beginBatch();
+}
+
 void PropertyBrowser::clear()
 {
     delete model_;
@@ -687,6 +810,13 @@ void PropertyBrowser::clear()
     setItemDelegateForColumn(PropertyModel::ColumnValue, new PropertyDelegate(this));
 }
 
+void PropertyBrowser::endUpdate()
+{
+    model_->endBatch();
+    // A reset collapses everything, batches are only used to populate so expand it all again.
+    if (!model_->inBatch()) { expandAll(); }
+}
+
 PropertyModel* PropertyBrowser::model() const noexcept
 {
     return model_;
@@ -4,6 +4,7 @@
 #include <QAbstractItemModel>
 #include <QCheckBox>
 #include <QComboBox>
+#include <QHash>
 #include <QLineEdit>
 #include <QObject>
 #include <QSpinBox>
@@ -162,6 +163,11 @@ enum struct PropertyType2 {
 
 struct EnumPropConfig {
     QAbstractItemModel* model = nullptr;
+
+    // Display string cache, valid while the value and the model's generation are unchanged
+    QVariant display;
+    int display_row = -1;
+    quint64 display_generation = 0;
 };
 
 struct StringPropConfig {
@@ -191,6 +197,8 @@ public:
     Property& operator=(const Property&) = delete;
     Property& operator=(Property&&) = delete;
 
+    /// Appends ``child`` and sets its parent and row
+    void appendChild(Property* child);
     void setEditable(bool val);
     void setReadOnly(bool val);
     void removeFromParent();
@@ -211,6 +219,7 @@ public:
 
     QList<Property*> children;
     Property* parent = nullptr;
+    int row = 0; ///< Index in ``parent->children`` or in the model's top level properties
 };
 
 // == PropertyDelegate ========================================================
@@ -246,7 +255,11 @@ public:
     ~PropertyModel();
 
     void addProperty(Property* prop, Property* parent = nullptr);
+    /// Starts a batch of changes, views are reset once when the outermost batch ends
+    void beginBatch();
     void deleteProperty(Property* prop);
+    void endBatch();
+    bool inBatch() const noexcept { return batch_depth_ > 0; }
     QModelIndex indexForProperty(Property* prop) const;
     void removeProperty(Property* prop);
     void replaceProperty(Property* old, Property* replacement);
@@ -267,8 +280,18 @@ signals:
     void propertyChanged(Property* prop);
 
 private:
+    QVariant enumDisplay(Property* prop) const;
+    quint64 enumGeneration(QAbstractItemModel* model) const;
+    /// Invalidates display strings of enum properties using ``model``
+    void enumModelChanged(QAbstractItemModel* model);
+    /// Tracks changes to the enum models used by ``prop`` and its children
+    void watchEnumModels(Property* prop);
+
+    /// Bumped whenever an enum model changes so cached display strings are recomputed
+    QHash<const QAbstractItemModel*, quint64> enum_generations_;
     QList<Property*> properties_;
     QUndoStack* undo_ = nullptr;
+    int batch_depth_ = 0;
 };
 
 class PropertyBrowser : public QTreeView {
@@ -283,7 +306,10 @@ public:
     Property* makeStringProperty(QString name, QString value, Property* parent = nullptr);
 
     void addProperty(Property* prop);
+    /// Defers view updates until ``endUpdate``, which resets the view once and expands all properties
+    void beginUpdate();
     void clear();
+    void endUpdate();
     PropertyModel* model() const noexcept;
     void setUndoStack(QUndoStack* undo);
 
@@ -25,17 +25,6 @@ ModelView::ModelView(QWidget* parent)
     yaw = 0.0f;
     pitch = -89.0f;
     updateCameraVectors();
-
-    QTimer* timer = new QTimer(this);
-    connect(timer, &QTimer::timeout, this, [this]() {
-        if (isVisible() && !isHidden() && isActiveWindow()) {
-            if (node_) {
-                node_->update(16);
-            }
-            render();
-        }
-    });
-    timer->start(16);
 }
 
 void ModelView::setNode(BasicTileArea* node)
@@ -49,6 +38,7 @@ void ModelView::setNode(BasicTileArea* node)
         cameraPosition = glm::vec3(centerX, centerY, 50.0f);
         updateCameraVectors();
     }
+    requestFrame();
 
     QTimer::singleShot(0, this, [this]() {
         this->setFocus(Qt::OtherFocusReason);
@@ -100,6 +90,8 @@ void ModelView::keyPressEvent(QKeyEvent* event)
             break;
         }
     }
+
+    requestFrame();
 }
 
 void ModelView::wheelEvent(QWheelEvent* event)
@@ -110,6 +102,19 @@ void ModelView::wheelEvent(QWheelEvent* event)
         cameraPosition -= cameraFront * wheelSpeed;
     }
     cameraPosition.z = std::max(1.0f, cameraPosition.z);
+    requestFrame();
+}
+
+bool ModelView::animating() const
+{
+    return node_ && node_->animating();
+}
+
+void ModelView::do_update(int32_t dt)
+{
+    if (node_) {
+        node_->update(dt);
+    }
 }
 
 void ModelView::do_render()
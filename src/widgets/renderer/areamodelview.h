@@ -18,7 +18,9 @@ public:
 
 protected:
     // void initializeGL() override;
+    bool animating() const override;
     void do_render() override;
+    void do_update(int32_t dt) override;
 
 private:
     BasicTileArea* node_ = nullptr;
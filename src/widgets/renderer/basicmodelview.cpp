@@ -7,7 +7,7 @@
 #include <glm/ext.hpp>
 
 #include <QMouseEvent>
-#include <QTimer>
+#include <QShowEvent>
 #include <QWheelEvent>
 
 BasicModelView::BasicModelView(QWidget* parent)
@@ -17,22 +17,32 @@ BasicModelView::BasicModelView(QWidget* parent)
     azimuth_ = 0.0f;
     declination_ = 0.0f;
     distance_ = 8.0f;
-
-    QTimer* timer = new QTimer(this);
-    connect(timer, &QTimer::timeout, this, [this]() {
-        if (isVisible() && !isHidden() && isActiveWindow()) {
-            if (current_model_) {
-                current_model_->update(16);
-            }
-            render();
-        }
-    });
-    timer->start(16);
 }
 
 void BasicModelView::setModel(std::unique_ptr<Model> model)
 {
     current_model_ = std::move(model);
+    requestFrame();
+}
+
+void BasicModelView::setModelLoader(std::function<std::unique_ptr<Model>()> loader)
+{
+    loader_ = std::move(loader);
+    if (isVisible()) {
+        auto load = std::move(loader_);
+        loader_ = nullptr;
+        setModel(load());
+    }
+}
+
+void BasicModelView::showEvent(QShowEvent* event)
+{
+    if (loader_) {
+        auto load = std::move(loader_);
+        loader_ = nullptr;
+        setModel(load());
+    }
+    RenderWidget::showEvent(event);
 }
 
 void BasicModelView::mousePressEvent(QMouseEvent* event)
@@ -51,6 +61,7 @@ void BasicModelView::mouseMoveEvent(QMouseEvent* event)
         declination_ += dy * 0.01f;
         declination_ = std::clamp(declination_, glm::radians(-89.0f), glm::radians(89.0f)); // Avoid poles
         last_pos_ = event->pos();
+        requestFrame();
     }
 }
 
@@ -60,6 +71,19 @@ void BasicModelView::wheelEvent(QWheelEvent* event)
     int num_steps = num_degrees / 15;
     distance_ -= num_steps;
     distance_ = std::clamp(distance_, 1.0f, 1000.0f);
+    requestFrame();
+}
+
+bool BasicModelView::animating() const
+{
+    return current_model_ && current_model_->animating();
+}
+
+void BasicModelView::do_update(int32_t dt)
+{
+    if (current_model_) {
+        current_model_->update(dt);
+    }
 }
 
 void BasicModelView::do_render()
@@ -4,6 +4,7 @@
 #include "../../services/renderer/model.hpp"
 #include "renderwidget.h"
 
+#include <functional>
 #include <memory>
 
 class QMouseEvent;
@@ -16,15 +17,22 @@ public:
 
     void setModel(std::unique_ptr<Model> model);
 
+    /// Sets a model to be loaded the next time the view is visible, loads immediately if it already is.
+    void setModelLoader(std::function<std::unique_ptr<Model>()> loader);
+
     void mousePressEvent(QMouseEvent* event) override;
     void mouseMoveEvent(QMouseEvent* event) override;
     void wheelEvent(QWheelEvent* event) override;
 
 protected:
+    void showEvent(QShowEvent* event) override;
+    bool animating() const override;
     void do_render() override;
+    void do_update(int32_t dt) override;
 
 private:
     std::unique_ptr<Model> current_model_ = nullptr;
+    std::function<std::unique_ptr<Model>()> loader_;
 
     QPoint last_pos_;
     float azimuth_;
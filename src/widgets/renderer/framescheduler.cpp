@@ -0,0 +1,51 @@
+#include "framescheduler.h"
+
+#include "renderwidget.h"
+
+#include <QGuiApplication>
+#include <QScreen>
+
+#include <algorithm>
+
+FrameScheduler::FrameScheduler(QObject* parent)
+    : QObject(parent)
+{
+    qreal rate = 60.0;
+    if (auto screen = QGuiApplication::primaryScreen(); screen && screen->refreshRate() > 0) {
+        rate = screen->refreshRate();
+    }
+
+    timer_.setTimerType(Qt::PreciseTimer);
+    timer_.setInterval(std::max(1, static_cast<int>(1000.0 / rate)));
+    connect(&timer_, &QTimer::timeout, this, &FrameScheduler::onTick);
+}
+
+void FrameScheduler::request(RenderWidget* widget)
+{
+    if (!widget || pending_.contains(widget)) { return; }
+    pending_.append(widget);
+    if (!timer_.isActive()) {
+        timer_.start();
+    }
+}
+
+void FrameScheduler::onTick()
+{
+    // Views that can't render right now, e.g. hidden tabs, are dropped, they'll
+    // request another frame when shown or activated.
+    while (!pending_.isEmpty()) {
+        QPointer<RenderWidget> widget = pending_.takeFirst();
+        if (widget && widget->render()) { break; }
+    }
+
+    if (pending_.isEmpty()) {
+        timer_.stop();
+    }
+}
+
+FrameScheduler& frame_scheduler()
+{
+    // Parented to the application so the timer is torn down with the event loop
+    static FrameScheduler* s_scheduler = new FrameScheduler(qApp);
+    return *s_scheduler;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+
+class RenderWidget;
+
+/// Drives rendering for all RenderWidgets.
+///
+/// Views request a frame when something they display changes, e.g. camera movement,
+/// input, a new model, or an animation that is playing.  Pending views are rendered
+/// one per display refresh in request order, nothing runs while no frames are pending.
+class FrameScheduler : public QObject {
+    Q_OBJECT
+
+public:
+    explicit FrameScheduler(QObject* parent = nullptr);
+
+    /// Queues a frame for ``widget``, a widget is only ever queued once
+    void request(RenderWidget* widget);
+
+private slots:
+    void onTick();
+
+private:
+    QTimer timer_;
+    QList<QPointer<RenderWidget>> pending_;
+};
+
+/// Gets the frame scheduler
+FrameScheduler& frame_scheduler();
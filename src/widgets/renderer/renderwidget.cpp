@@ -1,19 +1,22 @@
 #include "renderwidget.h"
 
 #include "../../services/renderer/renderservice.h"
+#include "framescheduler.h"
 
 #include <QApplication>
+#include <QFile>
+#include <QFileDialog>
+#include <QFontDatabase>
 #include <QImage>
 #include <QPainter>
 #include <QResizeEvent>
-#include <QTimer>
+#include <QShortcut>
+
+#include <algorithm>
+#include <sstream>
 
 RenderWidget::RenderWidget(QWidget* parent)
     : QWidget(parent)
-    , fboTexture_(nullptr)
-    , fboRTV_(nullptr)
-    , depthTexture_(nullptr)
-    , pDSV_(nullptr)
     , outputImage_(nullptr)
     , frameCounter_(0)
     , initialized_(false)
@@ -21,6 +24,17 @@ RenderWidget::RenderWidget(QWidget* parent)
 
     setAttribute(Qt::WA_OpaquePaintEvent);
     setFocusPolicy(Qt::StrongFocus);
+
+    auto toggleStats = new QShortcut(QKeySequence(Qt::Key_F3), this, nullptr, nullptr, Qt::WidgetShortcut);
+    connect(toggleStats, &QShortcut::activated, this, [this]() {
+        setStatsOverlayVisible(!showStats_);
+    });
+
+    auto exportShortcut = new QShortcut(QKeySequence(Qt::SHIFT | Qt::Key_F3), this, nullptr, nullptr, Qt::WidgetShortcut);
+    connect(exportShortcut, &QShortcut::activated, this, [this]() {
+        auto fn = QFileDialog::getSaveFileName(this, "Export Render Stats", "render_stats.csv", "CSV (*.csv)");
+        if (!fn.isEmpty()) { exportStats(fn); }
+    });
 }
 
 RenderWidget::~RenderWidget()
@@ -40,51 +54,9 @@ void RenderWidget::initialize()
         return;
     }
 
-    auto* device = renderer().device();
-    CHECK_F(!!device, "device is NULL - descriptor view creation failed!");
-
-    Diligent::TextureDesc ColorDesc;
-    ColorDesc.Name = "FBO Color Buffer";
-    ColorDesc.Type = Diligent::RESOURCE_DIM_TEX_2D;
-    ColorDesc.Width = width;
-    ColorDesc.Height = height;
-    ColorDesc.Format = Diligent::TEX_FORMAT_RGBA8_UNORM_SRGB; // Match your pipeline format
-    ColorDesc.BindFlags = Diligent::BIND_RENDER_TARGET | Diligent::BIND_SHADER_RESOURCE;
-    ColorDesc.Usage = Diligent::USAGE_DEFAULT;
-    ColorDesc.CPUAccessFlags = Diligent::CPU_ACCESS_NONE;
-
-    device->CreateTexture(ColorDesc, nullptr, &fboTexture_);
-    CHECK_F(!!fboTexture_, "fboTexture_ is NULL - descriptor view creation failed!");
-    fboRTV_ = fboTexture_->GetDefaultView(Diligent::TEXTURE_VIEW_RENDER_TARGET);
-    CHECK_F(!!fboRTV_, "fboRTV_ is NULL - descriptor view creation failed!");
-
-    Diligent::TextureDesc DepthDesc;
-    DepthDesc.Name = "FBO Depth Buffer";
-    DepthDesc.Type = Diligent::RESOURCE_DIM_TEX_2D;
-    DepthDesc.Width = width;
-    DepthDesc.Height = height;
-    DepthDesc.Format = Diligent::TEX_FORMAT_D32_FLOAT;
-    DepthDesc.BindFlags = Diligent::BIND_DEPTH_STENCIL;
-    DepthDesc.Usage = Diligent::USAGE_DEFAULT;
-    DepthDesc.CPUAccessFlags = Diligent::CPU_ACCESS_NONE;
-
-    device->CreateTexture(DepthDesc, nullptr, &depthTexture_);
-    CHECK_F(!!depthTexture_, "depthTexture_ is NULL - descriptor view creation failed!");
-    pDSV_ = depthTexture_->GetDefaultView(Diligent::TEXTURE_VIEW_DEPTH_STENCIL);
-    CHECK_F(!!pDSV_, "pDSV_ is NULL - descriptor view creation failed!");
-
-    Diligent::TextureDesc StagingDesc;
-    StagingDesc.Name = "Staging Texture";
-    StagingDesc.Type = Diligent::RESOURCE_DIM_TEX_2D;
-    StagingDesc.Width = width;
-    StagingDesc.Height = height;
-    StagingDesc.Format = Diligent::TEX_FORMAT_RGBA8_UNORM_SRGB; // Non-SRGB for CPU reading
-    StagingDesc.Usage = Diligent::USAGE_STAGING;
-    StagingDesc.CPUAccessFlags = Diligent::CPU_ACCESS_READ;
-    StagingDesc.BindFlags = Diligent::BIND_NONE;
-
-    device->CreateTexture(StagingDesc, nullptr, &stagingTexture_);
-    CHECK_F(!!stagingTexture_, "stagingTexture_ is NULL - descriptor view creation failed!");
+    if (!target_.initialize(uint32_t(width), uint32_t(height))) {
+        return;
+    }
 
     // Create QImage for displaying the rendered content
     delete outputImage_;
@@ -93,106 +65,67 @@ void RenderWidget::initialize()
     initialized_ = true;
 }
 
-void RenderWidget::transferFBOToQImage()
-{
-    if (!initialized_ || !fboTexture_ || !stagingTexture_ || !outputImage_)
-        return;
-
-    auto* ic = renderer().immediate_context();
-    if (!ic) { return; }
-
-    Diligent::CopyTextureAttribs CopyAttribs;
-    CopyAttribs.pSrcTexture = fboTexture_;
-    CopyAttribs.pDstTexture = stagingTexture_;
-    CopyAttribs.SrcTextureTransitionMode = Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
-    CopyAttribs.DstTextureTransitionMode = Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
-
-    ic->CopyTexture(CopyAttribs);
-
-    Diligent::MappedTextureSubresource MappedData;
-    ic->MapTextureSubresource(
-        stagingTexture_,
-        0,
-        0,
-        Diligent::MAP_READ,
-        Diligent::MAP_FLAG_DO_NOT_WAIT,
-        nullptr,
-        MappedData);
-
-    const int width = outputImage_->width();
-    const int height = outputImage_->height();
-
-    for (int y = 0; y < height; ++y) {
-        memcpy(
-            outputImage_->scanLine(y),
-            static_cast<const uint8_t*>(MappedData.pData) + y * MappedData.Stride,
-            width * 4);
-    }
-
-    ic->UnmapTextureSubresource(stagingTexture_, 0, 0);
-}
-
 void RenderWidget::cleanup()
 {
-    if (renderer().immediate_context()) {
-        renderer().immediate_context()->Flush();
-        renderer().immediate_context()->WaitForIdle();
-    }
-
-    fboRTV_.Release();
-    fboTexture_.Release();
-    pDSV_.Release();
-    depthTexture_.Release();
-    stagingTexture_.Release();
+    target_.release();
 
     delete outputImage_;
     outputImage_ = nullptr;
     initialized_ = false;
 }
 
+void RenderWidget::changeEvent(QEvent* event)
+{
+    if (event->type() == QEvent::ActivationChange && isActiveWindow()) {
+        requestFrame();
+    }
+    QWidget::changeEvent(event);
+}
+
 void RenderWidget::showEvent(QShowEvent* event)
 {
     if (!initialized_) {
         initialize();
     }
+    requestFrame();
     QWidget::showEvent(event);
 }
 
-void RenderWidget::renderToFBO()
+bool RenderWidget::render()
 {
-    if (!initialized_ || !fboRTV_ || !pDSV_ || !renderer().immediate_context())
-        return;
+    bool isInActiveTab = isVisible() && isVisibleTo(QApplication::activeWindow());
 
-    auto* immediateContext = renderer().immediate_context();
+    if (!isInActiveTab || !isActiveWindow() || !initialized_ || isMinimized() || !window()->isActiveWindow()) {
+        // Animation resumes from where it was rather than jumping ahead
+        frameClock_.invalidate();
+        return false;
+    }
 
-    Diligent::ITextureView* pRTVs[] = {fboRTV_};
-    immediateContext->SetRenderTargets(1, pRTVs, pDSV_, Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    // Clamped so that a stall doesn't skip a large part of an animation
+    int32_t dt = 0;
+    if (frameClock_.isValid()) {
+        dt = static_cast<int32_t>(std::min<qint64>(frameClock_.restart(), 100));
+    } else {
+        frameClock_.start();
+    }
 
-    const float ClearColor[] = {0.2f, 0.3f, 0.3f, 1.0f};
-    immediateContext->ClearRenderTarget(fboRTV_, ClearColor, Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
-    immediateContext->ClearDepthStencil(pDSV_, Diligent::CLEAR_DEPTH_FLAG, 1.0f, 0, Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    target_.render([this, dt]() { do_update(dt); }, [this]() { do_render(); }, outputImage_->bits(),
+        size_t(outputImage_->bytesPerLine()));
 
-    do_render();
+    update();
+    frameCounter_++;
 
-    immediateContext->SetRenderTargets(0, nullptr, nullptr, Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    if (animating()) {
+        requestFrame();
+    } else {
+        frameClock_.invalidate();
+    }
+    return true;
 }
 
-void RenderWidget::render()
+void RenderWidget::requestFrame()
 {
-    bool isInActiveTab = isVisible() && isVisibleTo(QApplication::activeWindow());
-
-    if (!isInActiveTab || !isActiveWindow() || !initialized_ || isMinimized() || !window()->isActiveWindow()) {
-        return;
-    }
-
-    renderer().pre_frame();
-    renderToFBO();
-    transferFBOToQImage();
-    renderer().immediate_context()->Flush();
-    renderer().immediate_context()->WaitForIdle();
-    renderer().immediate_context()->FinishFrame();
-    update();
-    frameCounter_++;
+    frame_scheduler().request(this);
 }
 
 void RenderWidget::paintEvent(QPaintEvent* event)
@@ -205,13 +138,88 @@ void RenderWidget::paintEvent(QPaintEvent* event)
 
     QPainter painter(this);
     painter.drawImage(rect(), *outputImage_);
+    if (showStats_) {
+        paintStatsOverlay(painter);
+    }
     QWidget::paintEvent(event);
 }
 
+void RenderWidget::paintStatsOverlay(QPainter& painter)
+{
+    const auto& stats = renderer().stats();
+    const auto& last = stats.last();
+    const auto avg = stats.average();
+
+    auto ms = [](double value) {
+        return value < 0.0 ? QString("n/a") : QString::number(value, 'f', 2);
+    };
+    auto kib = [](uint64_t bytes) {
+        return QString::number(double(bytes) / 1024.0, 'f', 1);
+    };
+
+    QStringList lines;
+    lines << QString("frame %1    last / avg of %2").arg(last.frame).arg(stats.history().size());
+    lines << QString("cpu       %1 / %2 ms").arg(ms(last.cpu_total_ms()), ms(avg.cpu_total_ms()));
+    lines << QString("gpu       %1 / %2 ms").arg(ms(last.gpu_ms), ms(avg.gpu_ms));
+    for (size_t i = 0; i < render_stage_count; ++i) {
+        lines << QString("  %1 %2 / %3 ms")
+                     .arg(render_stage_name(RenderStage(i)), -10)
+                     .arg(ms(last.cpu_ms[i]), ms(avg.cpu_ms[i]));
+    }
+    lines << QString("draws     %1 / %2").arg(last.draws).arg(avg.draws);
+    lines << QString("triangles %1 / %2").arg(last.triangles).arg(avg.triangles);
+    lines << QString("pso       %1 / %2").arg(last.pso_switches).arg(avg.pso_switches);
+    lines << QString("uploads   %1 (%2 KiB)").arg(last.texture_uploads).arg(kib(last.texture_upload_bytes));
+    lines << QString("readback  %1 KiB").arg(kib(last.readback_bytes));
+
+    painter.save();
+    painter.setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    const auto metrics = painter.fontMetrics();
+    int width = 0;
+    for (const auto& line : lines) {
+        width = std::max(width, metrics.horizontalAdvance(line));
+    }
+    const int margin = 6;
+    QRect box(margin, margin, width + 2 * margin, int(lines.size()) * metrics.height() + 2 * margin);
+    painter.fillRect(box, QColor(0, 0, 0, 160));
+    painter.setPen(Qt::white);
+    int y = box.top() + margin + metrics.ascent();
+    for (const auto& line : lines) {
+        painter.drawText(box.left() + margin, y, line);
+        y += metrics.height();
+    }
+    painter.restore();
+}
+
+void RenderWidget::setStatsOverlayVisible(bool visible)
+{
+    if (showStats_ == visible) { return; }
+    showStats_ = visible;
+    update();
+}
+
+bool RenderWidget::exportStats(const QString& path) const
+{
+    std::ostringstream out;
+    renderer().stats().write_csv(out);
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        LOG_F(ERROR, "[renderer] failed to open '{}'", path.toStdString());
+        return false;
+    }
+    auto csv = out.str();
+    file.write(csv.data(), qint64(csv.size()));
+    LOG_F(INFO, "[renderer] exported {} frames of render stats to '{}'", renderer().stats().history().size(),
+        path.toStdString());
+    return true;
+}
+
 void RenderWidget::resizeEvent(QResizeEvent* event)
 {
     if (initialized_) {
         initialize();
+        requestFrame();
     }
     QWidget::resizeEvent(event);
 }
@@ -1,15 +1,12 @@
 #pragma once
 
-#include <DiligentCore/Common/interface/RefCntAutoPtr.hpp>
-#include <DiligentCore/Graphics/GraphicsEngine/interface/DeviceContext.h>
-#include <DiligentCore/Graphics/GraphicsEngine/interface/Fence.h>
-#include <DiligentCore/Graphics/GraphicsEngine/interface/RenderDevice.h>
-#include <DiligentCore/Graphics/GraphicsEngine/interface/SwapChain.h>
-#include <DiligentCore/Graphics/GraphicsEngine/interface/Texture.h>
+#include "../../services/renderer/rendertarget.h"
 
+#include <QElapsedTimer>
 #include <QWidget>
 
 class QImage;
+class QPainter;
 
 class RenderWidget : public QWidget {
     Q_OBJECT
@@ -19,10 +16,21 @@ public:
     ~RenderWidget() override;
 
     void initialize();
-    void render();
+    /// Renders a frame now, returns false if the widget isn't visible in the active window
+    bool render();
+    /// Schedules a frame, see ``FrameScheduler``
+    void requestFrame();
     void cleanup();
 
+    /// Shows render statistics over the frame, toggled with F3
+    void setStatsOverlayVisible(bool visible);
+    bool statsOverlayVisible() const noexcept { return showStats_; }
+
+    /// Writes recent frame statistics as CSV, Shift+F3 prompts for a file
+    bool exportStats(const QString& path) const;
+
 protected:
+    void changeEvent(QEvent* event) override;
     void showEvent(QShowEvent* event) override;
     void paintEvent(QPaintEvent* event) override;
     void resizeEvent(QResizeEvent* event) override;
@@ -30,20 +38,22 @@ protected:
     // Override this method in subclasses to implement custom rendering
     virtual void do_render() { }
 
+    // Override to advance animations by ``dt`` milliseconds, called before ``do_render``
+    virtual void do_update(int32_t dt) { Q_UNUSED(dt); }
+
+    // Override to return true while frames should be rendered continuously
+    virtual bool animating() const { return false; }
+
 private:
-    void renderToFBO();
-    void transferFBOToQImage();
+    void paintStatsOverlay(QPainter& painter);
 
-    // FBO-related members
-    Diligent::RefCntAutoPtr<Diligent::ITexture> fboTexture_;
-    Diligent::RefCntAutoPtr<Diligent::ITextureView> fboRTV_;
-    Diligent::RefCntAutoPtr<Diligent::ITexture> depthTexture_;
-    Diligent::RefCntAutoPtr<Diligent::ITextureView> pDSV_;
-    Diligent::RefCntAutoPtr<Diligent::ITexture> stagingTexture_;
+    RenderTarget target_;
 
     // Qt-related members
     QImage* outputImage_;
 
+    QElapsedTimer frameClock_;
     int frameCounter_;
     bool initialized_;
+    bool showStats_ = false;
 };
@@ -14,7 +14,46 @@ StaticTwoDAModel::StaticTwoDAModel(const nw::StaticTwoDA* tda, int name_column,
 
 void StaticTwoDAModel::setColumns(QList<int> columns)
 {
+    beginResetModel();
     columns_ = std::move(columns);
+    display_.clear();
+    ranks_.clear();
+    endResetModel();
+}
+
+void StaticTwoDAModel::buildColumn(int column) const
+{
+    if (display_.size() != columnCount()) {
+        display_.resize(columnCount());
+        ranks_.resize(columnCount());
+    }
+    if (!display_[column].isEmpty() || tda_->rows() == 0) { return; }
+
+    int tda_column = columns_.empty() ? column : columns_[column];
+    QList<QVariant> values;
+    QList<QString> strings;
+    values.reserve(qsizetype(tda_->rows()));
+    strings.reserve(qsizetype(tda_->rows()));
+
+    for (size_t row = 0; row < tda_->rows(); ++row) {
+        QVariant value;
+        if (tda_column == name_column_) {
+            int string_id;
+            if (tda_->get_to(row, tda_column, string_id)) {
+                value = to_qstring(nw::kernel::strings().get(uint32_t(string_id)));
+            }
+        } else {
+            std::string str;
+            if (tda_->get_to(row, tda_column, str)) {
+                value = to_qstring(str);
+            }
+        }
+        strings.append(value.toString());
+        values.append(std::move(value));
+    }
+
+    display_[column] = std::move(values);
+    ranks_[column] = collation_ranks(strings);
 }
 
 QModelIndex StaticTwoDAModel::index(int row, int column, const QModelIndex& parent) const
@@ -50,21 +89,11 @@ int StaticTwoDAModel::columnCount(const QModelIndex& parent) const
 QVariant StaticTwoDAModel::data(const QModelIndex& index, int role) const
 {
     if (!index.isValid()) { return QVariant(); }
-    if (role != Qt::DisplayRole) { return QVariant(); }
-
-    int column = columns_.empty() ? index.column() : columns_[index.column()];
-    if (column == name_column_) {
-        int string_id;
-        if (tda_->get_to(index.row(), column, string_id)) {
-            return to_qstring(nw::kernel::strings().get(uint32_t(string_id)));
-        }
-        return QVariant();
-    }
+    if (role != Qt::DisplayRole && role != CollationRankRole) { return QVariant(); }
 
-    std::string value;
-    if (tda_->get_to(index.row(), column, value)) {
-        return to_qstring(value);
+    buildColumn(index.column());
+    if (role == CollationRankRole) {
+        return ranks_[index.column()][index.row()];
     }
-
-    return QVariant();
+    return display_[index.column()][index.row()];
 }
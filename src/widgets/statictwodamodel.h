@@ -7,6 +7,9 @@ namespace nw {
 struct StaticTwoDA;
 }
 
+/// Role for a row's collation rank, set as a proxy's sort role so sorting compares ints instead of strings
+constexpr int CollationRankRole = Qt::UserRole + 3;
+
 class StaticTwoDAModel : public QAbstractItemModel {
     Q_OBJECT
 
@@ -22,9 +25,15 @@ public:
     int rowCount(const QModelIndex& parent = QModelIndex()) const override;
 
 private:
+    void buildColumn(int column) const;
+
     const nw::StaticTwoDA* tda_;
     int name_column_;
     QList<int> columns_;
+
+    // Display strings and collation ranks per displayed column, built on first access.
+    mutable QList<QList<QVariant>> display_;
+    mutable QList<QList<int>> ranks_;
 };
 
 #endif // STATICTWODAMODEL_H
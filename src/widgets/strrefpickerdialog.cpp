@@ -0,0 +1,94 @@
+#include "strrefpickerdialog.h"
+
+#include "util/strings.h"
+
+#include "nw/kernel/Strings.hpp"
+
+#include <QDialogButtonBox>
+#include <QLabel>
+#include <QLineEdit>
+#include <QListWidget>
+#include <QVBoxLayout>
+
+namespace {
+
+// Results beyond this aren't useful in a list, the search should be refined instead.
+constexpr size_t max_results = 500;
+
+} // namespace
+
+StrrefPickerDialog::StrrefPickerDialog(const QString& search, QWidget* parent)
+    : QDialog(parent)
+{
+    setWindowTitle(tr("Find String"));
+
+    search_ = new QLineEdit(this);
+    search_->setPlaceholderText(tr("Search..."));
+    search_->setClearButtonEnabled(true);
+
+    results_ = new QListWidget(this);
+    results_->setUniformItemSizes(true);
+    status_ = new QLabel(this);
+
+    auto buttons = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel, this);
+    connect(buttons, &QDialogButtonBox::accepted, this, &QDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, this, &QDialog::reject);
+    connect(results_, &QListWidget::itemDoubleClicked, this, &QDialog::accept);
+    connect(search_, &QLineEdit::textChanged, this, &StrrefPickerDialog::onSearchChanged);
+
+    auto layout = new QVBoxLayout(this);
+    layout->addWidget(search_);
+    layout->addWidget(results_);
+    layout->addWidget(status_);
+    layout->addWidget(buttons);
+    resize(600, 400);
+
+    search_->setText(search);
+
+    auto future = kernel_tlk_index();
+    if (future.isFinished()) {
+        index_ = future.result();
+        onSearchChanged(search_->text());
+    } else {
+        status_->setText(tr("Indexing strings..."));
+        watcher_ = new QFutureWatcher<std::shared_ptr<const TlkIndex>>(this);
+        connect(watcher_, &QFutureWatcher<std::shared_ptr<const TlkIndex>>::finished, this, [this]() {
+            index_ = watcher_->result();
+            onSearchChanged(search_->text());
+        });
+        watcher_->setFuture(future);
+    }
+}
+
+uint32_t StrrefPickerDialog::strref() const
+{
+    auto item = results_->currentItem();
+    return item ? item->data(Qt::UserRole + 1).toUInt() : 0xFFFFFFFF;
+}
+
+void StrrefPickerDialog::onSearchChanged(const QString& text)
+{
+    if (!index_) { return; }
+
+    results_->clear();
+    if (text.isEmpty()) {
+        status_->clear();
+        return;
+    }
+
+    auto strrefs = index_->search(text.toStdString(), max_results + 1);
+    bool truncated = strrefs.size() > max_results;
+    if (truncated) { strrefs.resize(max_results); }
+
+    for (auto strref : strrefs) {
+        auto string = to_qstring(nw::kernel::strings().get(strref)).simplified();
+        auto item = new QListWidgetItem(QString("%1: %2").arg(strref).arg(string), results_);
+        item->setData(Qt::UserRole + 1, strref);
+    }
+    if (!strrefs.empty()) {
+        results_->setCurrentRow(0);
+    }
+
+    status_->setText(truncated ? tr("Showing first %1 matches").arg(max_results)
+                               : tr("%1 matches").arg(strrefs.size()));
+}
@@ -0,0 +1,34 @@
+#ifndef STRREFPICKERDIALOG_H
+#define STRREFPICKERDIALOG_H
+
+#include "util/tlkindex.h"
+
+#include <QDialog>
+#include <QFutureWatcher>
+
+class QLabel;
+class QLineEdit;
+class QListWidget;
+
+/// Searches the dialog and custom TLKs for a string and returns its strref
+class StrrefPickerDialog : public QDialog {
+    Q_OBJECT
+
+public:
+    explicit StrrefPickerDialog(const QString& search = {}, QWidget* parent = nullptr);
+
+    /// Selected strref, or 0xFFFFFFFF if nothing is selected
+    uint32_t strref() const;
+
+public slots:
+    void onSearchChanged(const QString& text);
+
+private:
+    QLineEdit* search_ = nullptr;
+    QListWidget* results_ = nullptr;
+    QLabel* status_ = nullptr;
+    std::shared_ptr<const TlkIndex> index_;
+    QFutureWatcher<std::shared_ptr<const TlkIndex>>* watcher_ = nullptr;
+};
+
+#endif // STRREFPICKERDIALOG_H
@@ -1,6 +1,7 @@
 #include "strreftextedit.h"
 #include "ui_strreftextedit.h"
 
+#include "strrefpickerdialog.h"
 #include "util/strings.h"
 
 #include "nw/kernel/Strings.hpp"
@@ -11,7 +12,7 @@ StrrefTextEdit::StrrefTextEdit(QWidget* parent)
 {
     ui->setupUi(this);
 
-    ui->strref->setMaximum(0x0FFFFFFF); // [TODO] make sure this is right.
+    ui->strref->setMaximum(0x01FFFFFF); // Custom TLK strrefs are flagged with 0x01000000
     ui->strrefShow->setChecked(locstring_.strref() != 0xFFFFFFFF);
     ui->feminine->setDisabled(lang_ == nw::LanguageID::english);
     ui->language->addItem("English", static_cast<int>(nw::LanguageID::english));
@@ -25,6 +26,7 @@ StrrefTextEdit::StrrefTextEdit(QWidget* parent)
     connect(ui->strref, &QSpinBox::valueChanged, this, &StrrefTextEdit::onStrrefChanged);
     connect(ui->strrefShow, &QCheckBox::toggled, this, &StrrefTextEdit::onStrrefShowToggled);
     connect(ui->feminine, &QCheckBox::toggled, this, &StrrefTextEdit::onFeminineToggled);
+    connect(ui->strrefFind, &QToolButton::clicked, this, &StrrefTextEdit::onFindStrref);
     connect(ui->textEdit, &QTextEdit::textChanged, this, &StrrefTextEdit::onTextEditChanged);
 }
 
@@ -83,6 +85,16 @@ void StrrefTextEdit::onFeminineToggled(bool value)
     updateTextEdit();
 }
 
+void StrrefTextEdit::onFindStrref()
+{
+    StrrefPickerDialog dlg({}, this);
+    if (dlg.exec() != QDialog::Accepted) { return; }
+
+    auto strref = dlg.strref();
+    if (strref == 0xFFFFFFFF) { return; }
+    ui->strref->setValue(int(strref));
+}
+
 void StrrefTextEdit::onLanguageChanged(int index)
 {
     if (index == -1) { return; }
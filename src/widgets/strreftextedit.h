@@ -22,6 +22,7 @@ public:
 
 public slots:
     void onFeminineToggled(bool value);
+    void onFindStrref();
     void onLanguageChanged(int index);
     void onStrrefChanged(int value);
     void onStrrefShowToggled(bool value);
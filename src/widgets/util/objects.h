@@ -1,5 +1,10 @@
 #pragma once
 
+#include "../../services/trace/trace.h"
+
+#include "nw/kernel/Objects.hpp"
+#include "nw/resources/Resource.hpp"
+
 namespace nw {
 struct Item;
 struct ObjectHandle;
@@ -16,3 +21,11 @@ QByteArray serialize_obj_handle(nw::ObjectHandle hndl);
 
 /// Creates an item icon
 QImage item_to_image(const nw::Item* item, bool female);
+
+/// Loads an object from a blueprint resource, traced as ``load_object``
+template <typename T>
+T* load_object(const nw::Resource& res)
+{
+    TRACE_SCOPE_ARG("load_object", res.filename());
+    return nw::kernel::objects().load<T>(res.resref);
+}
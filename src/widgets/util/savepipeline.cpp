@@ -0,0 +1,80 @@
+#include "savepipeline.h"
+
+#include "strings.h"
+
+#include "../../services/fileio/fileio.h"
+
+#include <nw/log.hpp>
+
+#include <QtConcurrent/QtConcurrent>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+SaveResult write_atomic(const QString& path, const SaveWriter& writer)
+{
+    SaveResult result{path, false, {}};
+
+    std::string error;
+    if (!write_file_atomic(fs::path{path.toStdString()}, writer, &error)) {
+        result.error = to_qstring(error);
+        LOG_F(ERROR, "[save] failed to save '{}': {}", path.toStdString(), error);
+        return result;
+    }
+
+    result.ok = true;
+    return result;
+}
+
+} // namespace
+
+SavePipeline::SavePipeline()
+{
+    pool_.setObjectName("SavePipeline");
+}
+
+SavePipeline::~SavePipeline()
+{
+    pool_.waitForDone();
+}
+
+bool SavePipeline::pending(const QString& path) const
+{
+    auto it = pending_.find(path);
+    return it != pending_.end() && !it->isFinished();
+}
+
+QFuture<SaveResult> SavePipeline::save(const QString& path, SaveWriter writer)
+{
+    // Drop bookkeeping for saves that have completed.
+    pending_.removeIf([](const auto& it) { return it.value().isFinished(); });
+
+    auto job = [path, writer = std::move(writer)]() {
+        return write_atomic(path, writer);
+    };
+
+    QFuture<SaveResult> result;
+    auto it = pending_.find(path);
+    if (it != pending_.end()) {
+        // Chain behind the previous save so that an older snapshot can never
+        // overwrite a newer one.
+        result = it->then(&pool_, [job](SaveResult) { return job(); });
+    } else {
+        result = QtConcurrent::run(&pool_, job);
+    }
+    pending_.insert(path, result);
+    return result;
+}
+
+void SavePipeline::waitForDone()
+{
+    pool_.waitForDone();
+    pending_.clear();
+}
+
+SavePipeline& save_pipeline()
+{
+    static SavePipeline s_pipeline;
+    return s_pipeline;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <QFuture>
+#include <QHash>
+#include <QString>
+#include <QThreadPool>
+
+#include <filesystem>
+#include <functional>
+
+/// Writes a snapshot to the given temporary path, runs on a worker thread.
+using SaveWriter = std::function<bool(const std::filesystem::path& temp)>;
+
+struct SaveResult {
+    QString path;
+    bool ok = false;
+    QString error;
+};
+
+/// Save pipeline shared by all editors.
+///
+/// Editors snapshot their object on the GUI thread into a ``SaveWriter``, the pipeline
+/// runs the writer on a worker thread against a temporary file in the destination
+/// directory, syncs it, and atomically renames it over the destination when the writer succeeds.
+/// Saves to the same path are run in the order they were requested.
+class SavePipeline {
+public:
+    SavePipeline();
+    SavePipeline(const SavePipeline&) = delete;
+    SavePipeline& operator=(const SavePipeline&) = delete;
+    ~SavePipeline();
+
+    /// Is a save to ``path`` queued or running
+    bool pending(const QString& path) const;
+
+    /// Queues ``writer`` to save to ``path``
+    QFuture<SaveResult> save(const QString& path, SaveWriter writer);
+
+    /// Blocks until all queued saves have finished
+    void waitForDone();
+
+private:
+    QThreadPool pool_;
+    QHash<QString, QFuture<SaveResult>> pending_;
+};
+
+/// Gets the save pipeline, must only be called from the GUI thread.
+SavePipeline& save_pipeline();
@@ -1,8 +1,40 @@
 #include "strings.h"
 
-#include <QString>
+#include <QCollator>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
 
 QString to_qstring(std::string_view view)
 {
     return QString::fromUtf8(view.data(), static_cast<qsizetype>(view.size()));
 }
+
+QList<int> collation_ranks(const QList<QString>& strings)
+{
+    QCollator collator;
+    collator.setNumericMode(true);
+
+    std::vector<QCollatorSortKey> keys;
+    keys.reserve(size_t(strings.size()));
+    for (const auto& str : strings) {
+        keys.push_back(collator.sortKey(str));
+    }
+
+    std::vector<int> order(keys.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&keys](int lhs, int rhs) {
+        return keys[size_t(lhs)].compare(keys[size_t(rhs)]) < 0;
+    });
+
+    QList<int> result(strings.size());
+    int rank = 0;
+    for (size_t i = 0; i < order.size(); ++i) {
+        if (i > 0 && keys[size_t(order[i - 1])].compare(keys[size_t(order[i])]) != 0) {
+            ++rank;
+        }
+        result[order[i]] = rank;
+    }
+    return result;
+}
@@ -1,7 +1,11 @@
 #pragma once
 
-#include <string_view>
+#include <QList>
+#include <QString>
 
-class QString;
+#include <string_view>
 
 QString to_qstring(std::string_view view);
+
+/// Gets the locale aware collation rank of each string, equal strings share a rank
+QList<int> collation_ranks(const QList<QString>& strings);
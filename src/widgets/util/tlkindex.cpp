@@ -0,0 +1,153 @@
+#include "tlkindex.h"
+
+#include <nw/kernel/Strings.hpp>
+#include <nw/log.hpp>
+
+#include <QElapsedTimer>
+#include <QtConcurrent/QtConcurrent>
+
+#include <algorithm>
+
+namespace {
+
+// Custom TLK strrefs are flagged with this bit.
+constexpr uint32_t custom_tlk_base = 0x01000000;
+
+char fold(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? char(c - 'A' + 'a') : c;
+}
+
+std::string fold(std::string_view text)
+{
+    std::string result{text};
+    std::transform(result.begin(), result.end(), result.begin(), [](char c) { return fold(c); });
+    return result;
+}
+
+uint32_t trigram(const char* p)
+{
+    return uint32_t(uint8_t(p[0])) << 16 | uint32_t(uint8_t(p[1])) << 8 | uint32_t(uint8_t(p[2]));
+}
+
+} // namespace
+
+TlkStrings copy_tlk_strings(const nw::Tlk& tlk, uint32_t base)
+{
+    TlkStrings result;
+    result.base = base;
+    result.strings.reserve(tlk.size());
+    for (uint32_t i = 0; i < uint32_t(tlk.size()); ++i) {
+        result.strings.emplace_back(tlk.get(i));
+    }
+    return result;
+}
+
+void TlkIndex::add(const TlkStrings& tlk)
+{
+    for (uint32_t i = 0; i < uint32_t(tlk.strings.size()); ++i) {
+        add_string(tlk.base + i, tlk.strings[i]);
+    }
+}
+
+void TlkIndex::add_string(uint32_t strref, std::string_view text)
+{
+    if (text.empty()) { return; }
+
+    auto id = uint32_t(strrefs_.size());
+    strrefs_.push_back(strref);
+    texts_.push_back(fold(text));
+
+    const auto& folded = texts_.back();
+    for (size_t i = 0; i + 3 <= folded.size(); ++i) {
+        auto& postings = trigrams_[trigram(folded.data() + i)];
+        // Ids are added in increasing order, so postings stay sorted and unique.
+        if (postings.empty() || postings.back() != id) {
+            postings.push_back(id);
+        }
+    }
+}
+
+std::vector<uint32_t> TlkIndex::search(std::string_view needle, size_t limit) const
+{
+    std::vector<uint32_t> result;
+    if (needle.empty()) { return result; }
+
+    auto folded = fold(needle);
+    auto matches = [&](uint32_t id) {
+        if (texts_[id].find(folded) == std::string::npos) { return true; }
+        result.push_back(strrefs_[id]);
+        return result.size() < limit;
+    };
+
+    // Too short for trigrams, short needles are cheap enough to scan.
+    if (folded.size() < 3) {
+        for (uint32_t id = 0; id < uint32_t(texts_.size()); ++id) {
+            if (!matches(id)) { break; }
+        }
+        return result;
+    }
+
+    std::vector<const std::vector<uint32_t>*> lists;
+    for (size_t i = 0; i + 3 <= folded.size(); ++i) {
+        auto it = trigrams_.find(trigram(folded.data() + i));
+        if (it == trigrams_.end()) { return result; }
+        lists.push_back(&it->second);
+    }
+    std::sort(lists.begin(), lists.end(), [](auto lhs, auto rhs) { return lhs->size() < rhs->size(); });
+    lists.erase(std::unique(lists.begin(), lists.end()), lists.end());
+
+    // Intersect smallest first so the candidate set shrinks as fast as possible.
+    std::vector<uint32_t> candidates = *lists[0];
+    std::vector<uint32_t> scratch;
+    for (size_t i = 1; i < lists.size() && !candidates.empty(); ++i) {
+        scratch.clear();
+        std::set_intersection(candidates.begin(), candidates.end(), lists[i]->begin(), lists[i]->end(),
+            std::back_inserter(scratch));
+        candidates.swap(scratch);
+    }
+
+    for (auto id : candidates) {
+        if (!matches(id)) { break; }
+    }
+    return result;
+}
+
+namespace {
+
+QFuture<std::shared_ptr<const TlkIndex>>& kernel_index_future()
+{
+    static QFuture<std::shared_ptr<const TlkIndex>> s_future;
+    return s_future;
+}
+
+} // namespace
+
+QFuture<std::shared_ptr<const TlkIndex>> kernel_tlk_index()
+{
+    auto& future = kernel_index_future();
+    if (!future.isValid()) {
+        std::vector<TlkStrings> tlks;
+        if (auto tlk = nw::kernel::strings().dialog()) { tlks.push_back(copy_tlk_strings(*tlk, 0)); }
+        if (auto tlk = nw::kernel::strings().custom()) { tlks.push_back(copy_tlk_strings(*tlk, custom_tlk_base)); }
+
+        future = QtConcurrent::run([tlks = std::move(tlks)]() -> std::shared_ptr<const TlkIndex> {
+            QElapsedTimer timer;
+            timer.start();
+
+            auto index = std::make_shared<TlkIndex>();
+            for (const auto& tlk : tlks) {
+                index->add(tlk);
+            }
+
+            LOG_F(INFO, "[tlk] indexed {} strings in {}ms", index->size(), timer.elapsed());
+            return index;
+        });
+    }
+    return future;
+}
+
+void reset_kernel_tlk_index()
+{
+    kernel_index_future() = {};
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <nw/config.hpp>
+#include <nw/i18n/Tlk.hpp>
+
+#include <absl/container/flat_hash_map.h>
+
+#include <QFuture>
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// A TLK's strings, copied on the thread that owns the TLK so an index can be built on another
+struct TlkStrings {
+    uint32_t base = 0; ///< Strref of the first string
+    std::vector<std::string> strings;
+};
+
+/// Copies every string in ``tlk``, strrefs are offset by ``base``
+TlkStrings copy_tlk_strings(const nw::Tlk& tlk, uint32_t base = 0);
+
+/// Case insensitive substring search over TLK strings.
+///
+/// Every string is split into byte trigrams, a query intersects the posting lists of its
+/// trigrams and verifies the remaining candidates. Immutable once built, safe to search
+/// from any thread.
+class TlkIndex {
+public:
+    /// Adds every string in ``tlk``
+    void add(const TlkStrings& tlk);
+
+    /// Finds strrefs whose text contains ``needle``, at most ``limit`` in strref order
+    std::vector<uint32_t> search(std::string_view needle, size_t limit = 1000) const;
+
+    /// ``search`` limit that returns every match
+    static constexpr size_t unlimited = std::numeric_limits<size_t>::max();
+
+    /// Number of indexed strings
+    size_t size() const noexcept { return strrefs_.size(); }
+
+private:
+    void add_string(uint32_t strref, std::string_view text);
+
+    std::vector<uint32_t> strrefs_;
+    std::vector<std::string> texts_; ///< Lower cased
+    absl::flat_hash_map<uint32_t, std::vector<uint32_t>> trigrams_;
+};
+
+/// Index over the kernel's dialog and custom TLKs, call on the GUI thread.
+///
+/// The first call copies the strings, the index is then built from the copy on a worker thread, so a
+/// module load replacing the custom TLK doesn't affect a build in progress.
+QFuture<std::shared_ptr<const TlkIndex>> kernel_tlk_index();
+
+/// Discards the kernel index so the next call to ``kernel_tlk_index`` rebuilds it, i.e. after loading a module
+void reset_kernel_tlk_index();
@@ -1,5 +1,7 @@
 #include "undocommands.h"
 
+#include <QDataStream>
+
 // == ComboBoxUndoCommand =====================================================
 // ============================================================================
 
@@ -40,12 +42,40 @@ VariantUndoCommand::VariantUndoCommand(const QVariant& last, const QVariant& nex
 {
 }
 
+qsizetype VariantUndoCommand::cost() const
+{
+    return HistoryCommand::cost() + variant_cost(last_) + variant_cost(next_);
+}
+
 void VariantUndoCommand::undo()
 {
+    if (!restore()) { return; }
     setter_(last_);
 }
 
 void VariantUndoCommand::redo()
 {
+    if (!restore()) { return; }
     setter_(next_);
 }
+
+bool VariantUndoCommand::canSpill() const
+{
+    return variant_streamable(last_) && variant_streamable(next_);
+}
+
+void VariantUndoCommand::save(QDataStream& stream) const
+{
+    stream << last_ << next_;
+}
+
+void VariantUndoCommand::load(QDataStream& stream)
+{
+    stream >> last_ >> next_;
+}
+
+void VariantUndoCommand::release()
+{
+    last_ = {};
+    next_ = {};
+}
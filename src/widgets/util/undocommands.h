@@ -1,5 +1,7 @@
 #pragma once
 
+#include "undohistory.h"
+
 #include <QUndoCommand>
 
 #include <QComboBox>
@@ -23,13 +25,20 @@ private:
     std::function<void(int)> callback_;
 };
 
-class VariantUndoCommand : public QUndoCommand {
+class VariantUndoCommand : public HistoryCommand {
 public:
     VariantUndoCommand(const QVariant& last, const QVariant& next, std::function<void(const QVariant& value)> setter);
 
+    qsizetype cost() const override;
     void undo() override;
     void redo() override;
 
+protected:
+    bool canSpill() const override;
+    void save(QDataStream& stream) const override;
+    void load(QDataStream& stream) override;
+    void release() override;
+
 private:
     QVariant last_;
     QVariant next_;
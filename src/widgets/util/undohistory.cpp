@@ -0,0 +1,381 @@
+#include "undohistory.h"
+
+#include "nw/log.hpp"
+
+#include <QDataStream>
+#include <QDir>
+#include <QTemporaryFile>
+#include <QUndoStack>
+
+#include <algorithm>
+
+namespace {
+
+// Edits to the same field closer together than this merge into one command.
+constexpr qint64 coalesce_window_ms = 1000;
+
+// The most recent commands are never spilled or expired, they're the likeliest to be undone.
+constexpr int hot_commands = 16;
+
+// Spill files are only rewritten once this much of them belongs to deleted commands.
+constexpr qint64 spill_compact_bytes = 4 * 1024 * 1024;
+
+HistoryCommand* history_command(const QUndoCommand* cmd)
+{
+    return const_cast<HistoryCommand*>(dynamic_cast<const HistoryCommand*>(cmd));
+}
+
+// Any command can expire, QUndoStack drops obsolete commands without undoing or redoing them.
+bool command_expired(const QUndoCommand* cmd)
+{
+    auto hc = dynamic_cast<const HistoryCommand*>(cmd);
+    return hc ? hc->expired() : cmd->isObsolete();
+}
+
+std::unique_ptr<QTemporaryFile> open_spill_file()
+{
+    auto result = std::make_unique<QTemporaryFile>(QDir::tempPath() + "/arclight-undo-XXXXXX");
+    if (!result->open()) { return {}; }
+    return result;
+}
+
+// Estimate for commands that don't report their own cost.
+qsizetype command_cost(const QUndoCommand* cmd)
+{
+    qsizetype result = 0;
+    if (auto hc = dynamic_cast<const HistoryCommand*>(cmd)) {
+        result = (hc->expired() || hc->spilled()) ? qsizetype(sizeof(HistoryCommand)) : hc->cost();
+    } else {
+        result = qsizetype(sizeof(QUndoCommand)) + cmd->text().size() * qsizetype(sizeof(QChar));
+    }
+    for (int i = 0; i < cmd->childCount(); ++i) {
+        result += command_cost(cmd->child(i));
+    }
+    return result;
+}
+
+} // namespace
+
+qsizetype variant_cost(const QVariant& value)
+{
+    switch (value.typeId()) {
+    default:
+        return qsizetype(sizeof(QVariant));
+    case QMetaType::QString:
+        return qsizetype(sizeof(QVariant)) + value.toString().size() * qsizetype(sizeof(QChar));
+    case QMetaType::QByteArray:
+        return qsizetype(sizeof(QVariant)) + value.toByteArray().size();
+    }
+}
+
+bool variant_streamable(const QVariant& value)
+{
+    return !value.isValid() || value.metaType().hasRegisteredDataStreamOperators();
+}
+
+// == FieldDelta ==============================================================
+// ============================================================================
+
+FieldDelta::FieldDelta(const QVariant& before, const QVariant& after)
+{
+    if (before.typeId() != QMetaType::QString || after.typeId() != QMetaType::QString) {
+        before_ = before;
+        after_ = after;
+        return;
+    }
+
+    auto lhs = before.toString();
+    auto rhs = after.toString();
+    qsizetype max = std::min(lhs.size(), rhs.size());
+
+    qsizetype prefix = 0;
+    while (prefix < max && lhs[prefix] == rhs[prefix]) {
+        ++prefix;
+    }
+    qsizetype suffix = 0;
+    while (suffix < max - prefix && lhs[lhs.size() - suffix - 1] == rhs[rhs.size() - suffix - 1]) {
+        ++suffix;
+    }
+
+    text_ = true;
+    pos_ = prefix;
+    removed_ = lhs.mid(prefix, lhs.size() - prefix - suffix);
+    inserted_ = rhs.mid(prefix, rhs.size() - prefix - suffix);
+}
+
+QVariant FieldDelta::before(const QVariant& after) const
+{
+    if (!text_) { return before_; }
+    auto text = after.toString();
+    return text.replace(pos_, inserted_.size(), removed_);
+}
+
+QVariant FieldDelta::after(const QVariant& before) const
+{
+    if (!text_) { return after_; }
+    auto text = before.toString();
+    return text.replace(pos_, removed_.size(), inserted_);
+}
+
+qsizetype FieldDelta::cost() const
+{
+    if (text_) {
+        return qsizetype(sizeof(FieldDelta)) + (removed_.size() + inserted_.size()) * qsizetype(sizeof(QChar));
+    }
+    return qsizetype(sizeof(FieldDelta)) + variant_cost(before_) + variant_cost(after_);
+}
+
+bool FieldDelta::streamable() const
+{
+    return text_ || (variant_streamable(before_) && variant_streamable(after_));
+}
+
+QDataStream& operator<<(QDataStream& stream, const FieldDelta& delta)
+{
+    stream << delta.text_;
+    if (delta.text_) {
+        stream << qint64(delta.pos_) << delta.removed_ << delta.inserted_;
+    } else {
+        stream << delta.before_ << delta.after_;
+    }
+    return stream;
+}
+
+QDataStream& operator>>(QDataStream& stream, FieldDelta& delta)
+{
+    stream >> delta.text_;
+    if (delta.text_) {
+        qint64 pos = 0;
+        stream >> pos >> delta.removed_ >> delta.inserted_;
+        delta.pos_ = qsizetype(pos);
+    } else {
+        stream >> delta.before_ >> delta.after_;
+    }
+    return stream;
+}
+
+// == HistoryCommand ==========================================================
+// ============================================================================
+
+HistoryCommand::HistoryCommand(QUndoCommand* parent)
+    : QUndoCommand(parent)
+{
+    last_edit_.start();
+}
+
+qsizetype HistoryCommand::cost() const
+{
+    return qsizetype(sizeof(HistoryCommand)) + text().size() * qsizetype(sizeof(QChar));
+}
+
+bool HistoryCommand::coalesces() const
+{
+    return !expired_ && last_edit_.isValid() && last_edit_.elapsed() < coalesce_window_ms;
+}
+
+void HistoryCommand::touch()
+{
+    last_edit_.restart();
+}
+
+bool HistoryCommand::restore()
+{
+    if (expired_) { return false; }
+    if (!spill_device_) { return true; }
+
+    if (!spill_device_->seek(spill_offset_)) {
+        LOG_F(ERROR, "[undo] failed to read spilled command '{}'", text().toStdString());
+        expire();
+        return false;
+    }
+
+    QDataStream stream(spill_device_);
+    load(stream);
+    spill_device_ = nullptr;
+    spill_offset_ = -1;
+    if (stream.status() != QDataStream::Ok) {
+        LOG_F(ERROR, "[undo] failed to read spilled command '{}'", text().toStdString());
+        expire();
+        return false;
+    }
+    return true;
+}
+
+void HistoryCommand::save(QDataStream&) const
+{
+}
+
+void HistoryCommand::load(QDataStream&)
+{
+}
+
+void HistoryCommand::expire()
+{
+    release();
+    expired_ = true;
+    spill_device_ = nullptr;
+    spill_offset_ = -1;
+    spill_size_ = 0;
+    // QUndoStack deletes obsolete commands when they're undone or redone.
+    setObsolete(true);
+}
+
+bool HistoryCommand::spill(QIODevice* device)
+{
+    if (!canSpill() || !device->seek(device->size())) { return false; }
+
+    auto offset = device->pos();
+    QDataStream stream(device);
+    save(stream);
+    if (stream.status() != QDataStream::Ok) { return false; }
+
+    release();
+    spill_device_ = device;
+    spill_offset_ = offset;
+    spill_size_ = device->pos() - offset;
+    return true;
+}
+
+// == UndoHistory =============================================================
+// ============================================================================
+
+UndoHistoryConfig& undo_history_config()
+{
+    static UndoHistoryConfig s_config;
+    return s_config;
+}
+
+UndoHistory::UndoHistory(QUndoStack* stack)
+    : QObject(stack)
+    , stack_{stack}
+    , config_{undo_history_config()}
+{
+    if (stack_->count() == 0) {
+        stack_->setUndoLimit(config_.limit);
+    }
+    connect(stack_, &QUndoStack::indexChanged, this, &UndoHistory::enforceBudget);
+}
+
+UndoHistory::~UndoHistory() = default;
+
+UndoHistory* UndoHistory::attach(QUndoStack* stack)
+{
+    if (auto existing = stack->findChild<UndoHistory*>(QString(), Qt::FindDirectChildrenOnly)) {
+        return existing;
+    }
+    return new UndoHistory(stack);
+}
+
+qsizetype UndoHistory::memoryUsage() const
+{
+    qsizetype result = 0;
+    for (int i = 0; i < stack_->count(); ++i) {
+        result += command_cost(stack_->command(i));
+    }
+    return result;
+}
+
+void UndoHistory::compactSpill()
+{
+    if (!spill_) { return; }
+
+    QList<HistoryCommand*> spilled;
+    qint64 live = 0;
+    for (int i = 0; i < stack_->count(); ++i) {
+        auto cmd = history_command(stack_->command(i));
+        if (cmd && cmd->spilled()) {
+            spilled.push_back(cmd);
+            live += cmd->spill_size_;
+        }
+    }
+
+    // Pushing discards the redo branch and the undo limit drops the oldest commands, their
+    // payloads stay in the file.
+    if (spilled.isEmpty()) {
+        spill_.reset();
+        return;
+    }
+    if (spill_->size() - live < std::max(live, spill_compact_bytes)) { return; }
+
+    auto file = open_spill_file();
+    if (!file) { return; }
+    for (auto cmd : spilled) {
+        QByteArray payload;
+        if (spill_->seek(cmd->spill_offset_)) {
+            payload = spill_->read(cmd->spill_size_);
+        }
+        if (payload.size() != cmd->spill_size_) {
+            LOG_F(ERROR, "[undo] failed to read spilled command '{}'", cmd->text().toStdString());
+            cmd->expire();
+            continue;
+        }
+        cmd->spill_device_ = file.get();
+        cmd->spill_offset_ = file->pos();
+        file->write(payload);
+    }
+    spill_ = std::move(file);
+}
+
+void UndoHistory::enforceBudget()
+{
+    compactSpill();
+
+    auto usage = memoryUsage();
+    if (usage > config_.budget) {
+        if (config_.spill_to_disk && !spill_) {
+            spill_ = open_spill_file();
+            if (!spill_) {
+                LOG_F(ERROR, "[undo] failed to open spill file, old history will be released instead");
+            }
+        }
+
+        // Spilling loses nothing and can happen anywhere.  Expiring only eats into the oldest end,
+        // i.e. text deltas are relative to the next value, so older commands can't skip over one.
+        // Commands that aren't a ``HistoryCommand`` free nothing but still expire, or they'd stop
+        // expiry from getting past them.
+        bool oldest = true;
+        int end = stack_->index() - hot_commands;
+        for (int i = 0; i < end && usage > config_.budget; ++i) {
+            auto cmd = stack_->command(i);
+            if (command_expired(cmd)) { continue; }
+            auto hc = history_command(cmd);
+            if (hc && hc->spilled()) {
+                oldest = false;
+                continue;
+            }
+
+            auto before = command_cost(cmd);
+            if (hc && spill_ && hc->spill(spill_.get())) {
+                oldest = false;
+            } else if (oldest) {
+                expire(cmd);
+            } else {
+                continue;
+            }
+            usage -= before - command_cost(cmd);
+        }
+    }
+
+    // A failed restore can expire a command anywhere, nothing older can be undone past it.
+    int floor = -1;
+    for (int i = std::min(stack_->index(), stack_->count()) - 1; i >= 0 && floor < 0; --i) {
+        if (command_expired(stack_->command(i))) { floor = i; }
+    }
+    for (int i = 0; i < floor; ++i) {
+        if (!command_expired(stack_->command(i))) { expire(stack_->command(i)); }
+    }
+}
+
+void UndoHistory::expire(const QUndoCommand* cmd)
+{
+    auto command = const_cast<QUndoCommand*>(cmd);
+    if (auto hc = history_command(command)) {
+        hc->expire();
+    } else {
+        command->setObsolete(true);
+    }
+    // Children of a macro hold its payload.
+    for (int i = 0; i < command->childCount(); ++i) {
+        expire(command->child(i));
+    }
+}
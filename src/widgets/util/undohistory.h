@@ -0,0 +1,137 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QUndoCommand>
+#include <QVariant>
+
+#include <memory>
+
+class QDataStream;
+class QIODevice;
+class QTemporaryFile;
+class QUndoStack;
+
+/// Approximate heap footprint of a value in bytes
+qsizetype variant_cost(const QVariant& value);
+
+/// Whether a value can be written to a data stream
+bool variant_streamable(const QVariant& value);
+
+// == FieldDelta ==============================================================
+// ============================================================================
+
+/// Change of a single field's value.
+///
+/// Strings only keep the edited span, so typing into a long description doesn't store a copy
+/// of the whole text per step. Other values keep both sides.
+class FieldDelta {
+public:
+    FieldDelta() = default;
+    FieldDelta(const QVariant& before, const QVariant& after);
+
+    /// Reconstructs the previous value from the current one
+    QVariant before(const QVariant& after) const;
+    /// Reconstructs the next value from the current one
+    QVariant after(const QVariant& before) const;
+
+    /// Approximate heap footprint in bytes
+    qsizetype cost() const;
+    /// Whether the delta can be written to a data stream
+    bool streamable() const;
+
+    friend QDataStream& operator<<(QDataStream& stream, const FieldDelta& delta);
+    friend QDataStream& operator>>(QDataStream& stream, FieldDelta& delta);
+
+private:
+    bool text_ = false;
+    qsizetype pos_ = 0;
+    QString removed_;
+    QString inserted_;
+    QVariant before_;
+    QVariant after_;
+};
+
+// == HistoryCommand ==========================================================
+// ============================================================================
+
+/// Undo command that takes part in an ``UndoHistory`` memory budget.
+///
+/// Once a command is deep enough in the history its payload is either spilled to disk, if the
+/// command supports it and spilling is enabled, or released. Released commands expire, they do
+/// nothing when reached and are dropped from the stack. Only the oldest commands expire, of any
+/// type, and everything older than an expired command expires with it, so undo stops there
+/// instead of applying older changes to the wrong state. Subclasses must call ``restore`` before
+/// touching their payload in ``undo``, ``redo`` and ``mergeWith`` and bail if it returns false.
+class HistoryCommand : public QUndoCommand {
+public:
+    explicit HistoryCommand(QUndoCommand* parent = nullptr);
+
+    /// Approximate heap footprint in bytes, including the payload
+    virtual qsizetype cost() const;
+    bool expired() const noexcept { return expired_; }
+    bool spilled() const noexcept { return spill_device_ != nullptr; }
+
+protected:
+    /// True if the last edit happened recently enough for the next one to merge into it
+    bool coalesces() const;
+    /// Restarts the coalescing window
+    void touch();
+    /// Reads a spilled payload back in, returns false if the command has expired
+    bool restore();
+
+    virtual bool canSpill() const { return false; }
+    virtual void save(QDataStream& stream) const;
+    virtual void load(QDataStream& stream);
+    /// Frees the payload after it has been spilled or when the command expires
+    virtual void release() { }
+
+private:
+    friend class UndoHistory;
+
+    void expire();
+    bool spill(QIODevice* device);
+
+    QElapsedTimer last_edit_;
+    QIODevice* spill_device_ = nullptr;
+    qint64 spill_offset_ = -1;
+    qint64 spill_size_ = 0;
+    bool expired_ = false;
+};
+
+// == UndoHistory =============================================================
+// ============================================================================
+
+struct UndoHistoryConfig {
+    qsizetype budget = 16 * 1024 * 1024; ///< Per stack, in bytes
+    int limit = 1000;                    ///< Maximum number of commands per stack
+    bool spill_to_disk = false;          ///< Spill old payloads to a temporary file instead of releasing them
+};
+
+/// Global settings for stacks attached after they are changed
+UndoHistoryConfig& undo_history_config();
+
+/// Keeps a ``QUndoStack`` within a command limit and a memory budget
+class UndoHistory : public QObject {
+    Q_OBJECT
+public:
+    /// Attaches to ``stack``, which should still be empty so the command limit can be applied
+    static UndoHistory* attach(QUndoStack* stack);
+    ~UndoHistory();
+
+    /// Current in memory footprint of the stack's commands in bytes
+    qsizetype memoryUsage() const;
+
+private:
+    explicit UndoHistory(QUndoStack* stack);
+
+    /// Drops the spill file once no command uses it, or rewrites it when most of it is dead
+    void compactSpill();
+    void enforceBudget();
+    /// Expires ``cmd`` and its children, whatever their type
+    static void expire(const QUndoCommand* cmd);
+
+    QUndoStack* stack_;
+    UndoHistoryConfig config_;
+    std::unique_ptr<QTemporaryFile> spill_;
+};